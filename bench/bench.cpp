@@ -1,4 +1,5 @@
 #include "mandelbrot/mandelbrot.hpp"
+#include "mandelbrot/png.hpp"
 #include <benchmark/benchmark.h>
 #include <complex>
 #include <format>
@@ -193,4 +194,409 @@ BENCHMARK(BM_Mandelbrot_MT_SIMD)
     ->Args({1, PIXEL_COUNT, THREAD_COUNT})
     ->Args({2, PIXEL_COUNT, THREAD_COUNT});
 
+/// Tile renderer scenes
+struct TileScene {
+  mandelbrot::tile::viewport view;
+  std::string_view name;
+};
+
+constexpr TileScene tile_scenes[] = {
+    {{-0.7, 0.0, 0.8, 1920, 1080}, "DefaultView"},   // The viewer's start-up view
+    {{-0.15, 0.3, 6.0, 1920, 1080}, "InteriorView"}, // Mostly inside the main cardioid
+};
+
+static mandelbrot::tile::iteration_map tile_map;
+
+static void TileSetup(const benchmark::State &state) {
+  pool = std::make_unique<exec::static_thread_pool>(state.range(2));
+}
+static void TileTeardown(const benchmark::State &state) { pool.reset(); }
+
+static void BM_Tile_Strategy(benchmark::State &state) {
+  auto const &scene = tile_scenes[state.range(0)];
+  auto const strategy = static_cast<mandelbrot::tile::strategy>(state.range(1));
+  state.SetLabel(
+      std::format("Tile renderer {} [{}]", mandelbrot::tile::to_string(strategy), scene.name)
+  );
+
+  auto scheduler = pool->get_scheduler();
+  auto computed = std::size_t{};
+  for (auto _ : state) {
+    auto start = std::chrono::high_resolution_clock::now();
+    computed = mandelbrot::tile::render<MAX_ITER>(scene.view, tile_map, scheduler, strategy);
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    state.SetIterationTime(elapsed_seconds.count());
+    benchmark::ClobberMemory();
+  }
+  auto const pixels = double(scene.view.width * scene.view.height);
+  state.counters["calc"] =
+      benchmark::Counter(pixels, benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["computed"] = double(computed) / pixels;
+}
+BENCHMARK(BM_Tile_Strategy)
+    ->UseManualTime()
+    ->Setup(TileSetup)
+    ->Teardown(TileTeardown)
+    ->Args({0, int(mandelbrot::tile::strategy::brute_force), THREAD_COUNT})
+    ->Args({0, int(mandelbrot::tile::strategy::subdivide), THREAD_COUNT})
+    ->Args({0, int(mandelbrot::tile::strategy::boundary_trace), THREAD_COUNT})
+    ->Args({1, int(mandelbrot::tile::strategy::brute_force), THREAD_COUNT})
+    ->Args({1, int(mandelbrot::tile::strategy::subdivide), THREAD_COUNT})
+    ->Args({1, int(mandelbrot::tile::strategy::boundary_trace), THREAD_COUNT});
+
+static void BM_Tile_Balance(benchmark::State &state) {
+  auto const predicted = state.range(0) != 0;
+  state.SetLabel(std::format("Row bands, {} split [ZoomSequence]", predicted ? "cost" : "even"));
+
+  // Twelve 1.25x zoom steps towards the seahorse valley, as the viewer's wheel would
+  constexpr auto FRAMES = 12uz;
+  auto const workers = std::size_t(state.range(1));
+  auto scheduler = pool->get_scheduler();
+  auto idle = 0.0;
+  for (auto _ : state) {
+    auto model = mandelbrot::tile::cost_model{};
+    auto view = tile_scenes[0].view;
+    auto elapsed = 0.0;
+    idle = 0.0;
+    for (std::size_t frame = 0; frame != FRAMES; ++frame) {
+      auto const report = mandelbrot::tile::render_balanced<MAX_ITER>(
+          view, tile_map, scheduler, workers, predicted ? &model : nullptr
+      );
+      elapsed += report.wall_seconds;
+      idle += report.idle_fraction / FRAMES;
+      view.center_x += (-0.745 - view.center_x) * 0.2;
+      view.center_y += (0.11 - view.center_y) * 0.2;
+      view.zoom *= 1.25;
+    }
+    state.SetIterationTime(elapsed);
+    benchmark::ClobberMemory();
+  }
+  auto const pixels = double(FRAMES * tile_scenes[0].view.width * tile_scenes[0].view.height);
+  state.counters["calc"] =
+      benchmark::Counter(pixels, benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["idle"] = idle;
+}
+BENCHMARK(BM_Tile_Balance)
+    ->UseManualTime()
+    ->Setup(TileSetup)
+    ->Teardown(TileTeardown)
+    ->Args({0, THREAD_COUNT, THREAD_COUNT})
+    ->Args({1, THREAD_COUNT, THREAD_COUNT});
+
+/// Scheduler backend matrix: same work on each enabled backend
+static std::unique_ptr<mandelbrot::backend_pool> backend_pool;
+
+static void BackendSetup(const benchmark::State &state) {
+  backend_pool = std::make_unique<mandelbrot::backend_pool>(state.range(2));
+}
+static void BackendTeardown(const benchmark::State &state) { backend_pool.reset(); }
+
+static void BM_Backend_MT_SIMD(benchmark::State &state) {
+  auto const &test_point = test_points[state.range(0)];
+  auto const kind = static_cast<mandelbrot::backend>(state.range(1));
+  state.SetLabel(
+      std::format("Multithreaded + SIMD on {} [{}]", mandelbrot::to_string(kind), test_point.name)
+  );
+  if (!mandelbrot::available(kind)) {
+    state.SkipWithError("backend not enabled in this build");
+    return;
+  }
+
+  using batch = xsimd::batch<double>;
+  auto a = batch(test_point.point.real());
+  auto b = batch(test_point.point.imag());
+  auto gen = [=](std::size_t) { return std::pair{a, b}; };
+
+  data_simd.resize(PIXEL_COUNT / batch::size);
+  auto scheduler = backend_pool->get_scheduler(kind);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(gen);
+    auto start = std::chrono::high_resolution_clock::now();
+    mandelbrot::v8::mandelbrot<MAX_ITER>(data_simd, gen, scheduler);
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    state.SetIterationTime(elapsed_seconds.count());
+    benchmark::ClobberMemory();
+  }
+  state.counters["calc"] =
+      benchmark::Counter(double(PIXEL_COUNT), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_Backend_MT_SIMD)
+    ->UseManualTime()
+    ->Setup(BackendSetup)
+    ->Teardown(BackendTeardown)
+    ->ArgsProduct({
+        {0, 2},
+        benchmark::CreateDenseRange(0, int(mandelbrot::backend::count) - 1, 1),
+        {THREAD_COUNT},
+    });
+
+static void BM_Tile_Backend(benchmark::State &state) {
+  auto const &scene = tile_scenes[state.range(0)];
+  auto const kind = static_cast<mandelbrot::backend>(state.range(1));
+  state.SetLabel(std::format("Tile renderer on {} [{}]", mandelbrot::to_string(kind), scene.name));
+  if (!mandelbrot::available(kind)) {
+    state.SkipWithError("backend not enabled in this build");
+    return;
+  }
+
+  auto scheduler = backend_pool->get_scheduler(kind);
+  for (auto _ : state) {
+    auto start = std::chrono::high_resolution_clock::now();
+    mandelbrot::tile::render<MAX_ITER>(scene.view, tile_map, scheduler);
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    state.SetIterationTime(elapsed_seconds.count());
+    benchmark::ClobberMemory();
+  }
+  auto const pixels = double(scene.view.width * scene.view.height);
+  state.counters["calc"] =
+      benchmark::Counter(pixels, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_Tile_Backend)
+    ->UseManualTime()
+    ->Setup(BackendSetup)
+    ->Teardown(BackendTeardown)
+    ->ArgsProduct({
+        {0, 1},
+        benchmark::CreateDenseRange(0, int(mandelbrot::backend::count) - 1, 1),
+        {THREAD_COUNT},
+    });
+
+/// Colour pass: formula vs palette lookup over the samples of a rendered frame
+static std::vector<double> colour_iter;
+static std::vector<double> colour_mag;
+
+static void ColourSetup(const benchmark::State &state) {
+  auto render_pool = exec::static_thread_pool(THREAD_COUNT);
+  auto map = mandelbrot::tile::iteration_map{};
+  mandelbrot::tile::render<MAX_ITER>(tile_scenes[0].view, map, render_pool.get_scheduler());
+  colour_iter.assign(map.iter.begin(), map.iter.end());
+  colour_mag = map.mag;
+}
+static void ColourTeardown(const benchmark::State &state) {
+  colour_iter = {};
+  colour_mag = {};
+}
+
+static void BM_Colour(benchmark::State &state) {
+  using mandelbrot::colour::batch;
+  auto const scheme = static_cast<mandelbrot::colour::scheme>(state.range(0));
+  auto const use_palette = state.range(1) != 0;
+  state.SetLabel(std::format(
+      "Colour {} [{}]", use_palette ? "palette" : "formula", mandelbrot::colour::to_string(scheme)
+  ));
+
+  auto const palette = mandelbrot::colour::palette::build<MAX_ITER>(scheme);
+  auto const samples = colour_iter.size() / batch::size * batch::size;
+  auto out = std::vector<double>(samples * 3);
+  for (auto _ : state) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i != samples; i += batch::size) {
+      auto const t = mandelbrot::colour::normalized<MAX_ITER>(
+          batch::load_unaligned(colour_iter.data() + i),
+          batch::load_unaligned(colour_mag.data() + i),
+          true
+      );
+      auto const [r, g, b] = use_palette ? palette.sample(t)
+                                         : mandelbrot::colour::shade_exact<MAX_ITER>(scheme, t);
+      r.store_unaligned(out.data() + i);
+      g.store_unaligned(out.data() + samples + i);
+      b.store_unaligned(out.data() + 2 * samples + i);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    state.SetIterationTime(elapsed_seconds.count());
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.counters["samples"] =
+      benchmark::Counter(double(samples), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_Colour)
+    ->UseManualTime()
+    ->Setup(ColourSetup)
+    ->Teardown(ColourTeardown)
+    ->ArgsProduct({
+        {int(mandelbrot::colour::scheme::classic),
+         int(mandelbrot::colour::scheme::exponential_lch),
+         int(mandelbrot::colour::scheme::rainbow_spiral)},
+        {0, 1},
+    });
+
+/// Anti-aliasing: every pixel supersampled vs refining only where neighbours differ
+static void BM_Tile_AntiAliasing(benchmark::State &state) {
+  auto const &scene = tile_scenes[state.range(0)];
+  auto const adaptive = state.range(1) != 0;
+  constexpr auto n = 4uz; // The viewer's 16x level
+  state.SetLabel(std::format("16x {} AA [{}]", adaptive ? "adaptive" : "uniform", scene.name));
+
+  auto const &vp = scene.view;
+  auto const fine = mandelbrot::tile::viewport{
+      vp.center_x, vp.center_y, vp.zoom, vp.width * n, vp.height * n
+  };
+  auto const frame = mandelbrot::tile::rect{0, 0, vp.width, vp.height};
+  auto scheduler = pool->get_scheduler();
+  auto centres = mandelbrot::tile::iteration_map{};
+  auto refined = std::size_t{};
+  for (auto _ : state) {
+    auto start = std::chrono::high_resolution_clock::now();
+    if (adaptive) {
+      tile_map.resize(fine.width, fine.height);
+      mandelbrot::tile::render<MAX_ITER>(vp, centres, scheduler);
+      refined = mandelbrot::tile::refine_adaptive<MAX_ITER>(
+          vp, centres, tile_map, n, frame, scheduler, true
+      );
+    } else {
+      mandelbrot::tile::render<MAX_ITER>(fine, tile_map, scheduler);
+      refined = frame.area();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    state.SetIterationTime(elapsed_seconds.count());
+    benchmark::ClobberMemory();
+  }
+  state.counters["calc"] =
+      benchmark::Counter(double(frame.area()), benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["refined"] = double(refined) / double(frame.area());
+}
+BENCHMARK(BM_Tile_AntiAliasing)
+    ->UseManualTime()
+    ->Setup(TileSetup)
+    ->Teardown(TileTeardown)
+    ->ArgsProduct({{0, 1}, {0, 1}, {THREAD_COUNT}});
+
+/// World tile cache: every tile computed (cold) vs served from the cache (warm)
+static void BM_Tile_Cache(benchmark::State &state) {
+  auto const &scene = tile_scenes[state.range(0)];
+  auto const warm = state.range(1) != 0;
+  state.SetLabel(std::format("Tile cache {} [{}]", warm ? "warm" : "cold", scene.name));
+
+  auto const frame = mandelbrot::tile::rect{0, 0, scene.view.width, scene.view.height};
+  auto scheduler = pool->get_scheduler();
+  auto cache = mandelbrot::tile::tile_cache{1uz << 30};
+  tile_map.resize(frame.width, frame.height);
+  if (warm) {
+    mandelbrot::tile::render_cached<MAX_ITER>(scene.view, tile_map, 1, frame, scheduler, cache);
+    cache.reset_stats();
+  }
+  for (auto _ : state) {
+    if (!warm) {
+      cache.clear();
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    mandelbrot::tile::render_cached<MAX_ITER>(scene.view, tile_map, 1, frame, scheduler, cache);
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    state.SetIterationTime(elapsed_seconds.count());
+    benchmark::ClobberMemory();
+  }
+  state.counters["calc"] =
+      benchmark::Counter(double(frame.area()), benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["hit_rate"] = cache.hit_rate();
+}
+BENCHMARK(BM_Tile_Cache)
+    ->UseManualTime()
+    ->Setup(TileSetup)
+    ->Teardown(TileTeardown)
+    ->ArgsProduct({{0, 1}, {0, 1}, {THREAD_COUNT}});
+
+/// Raising the limit: a render at the deep limit vs deepening the interior of a shallow one
+static void BM_Tile_Deepen(benchmark::State &state) {
+  constexpr auto SHALLOW = MAX_ITER / 10;
+  auto const &scene = tile_scenes[state.range(0)];
+  auto const deepen = state.range(1) != 0;
+  state.SetLabel(
+      std::format("Limit {} to {} [{}]", deepen ? "deepened" : "rendered", MAX_ITER, scene.name)
+  );
+
+  auto scheduler = pool->get_scheduler();
+  auto shallow = mandelbrot::tile::iteration_map{};
+  mandelbrot::tile::render<SHALLOW>(scene.view, shallow, scheduler);
+  auto inside = std::size_t{};
+  for (auto _ : state) {
+    tile_map = shallow;
+    auto start = std::chrono::high_resolution_clock::now();
+    if (deepen) {
+      auto interior = mandelbrot::tile::find_interior(tile_map, SHALLOW);
+      inside = interior.size();
+      mandelbrot::tile::deepen<MAX_ITER>(
+          scene.view, tile_map, interior, 0, interior.size(), scheduler
+      );
+      mandelbrot::tile::settle(tile_map, interior, MAX_ITER);
+    } else {
+      mandelbrot::tile::render<MAX_ITER>(scene.view, tile_map, scheduler);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    state.SetIterationTime(elapsed_seconds.count());
+    benchmark::ClobberMemory();
+  }
+  auto const pixels = double(scene.view.width * scene.view.height);
+  state.counters["calc"] =
+      benchmark::Counter(pixels, benchmark::Counter::kIsIterationInvariantRate);
+  if (deepen) {
+    state.counters["deepened"] = double(inside) / pixels;
+  }
+}
+BENCHMARK(BM_Tile_Deepen)
+    ->UseManualTime()
+    ->Setup(TileSetup)
+    ->Teardown(TileTeardown)
+    ->ArgsProduct({{0, 1}, {0, 1}, {THREAD_COUNT}});
+
+/// Image encoders: PNG and QOI, serial vs blocks encoded in parallel on the render pool
+static mandelbrot::rgb_image encode_image;
+
+static void EncodeSetup(const benchmark::State &state) {
+  pool = std::make_unique<exec::static_thread_pool>(state.range(2));
+  auto map = mandelbrot::tile::iteration_map{};
+  mandelbrot::tile::render<MAX_ITER>(tile_scenes[0].view, map, pool->get_scheduler());
+  auto const palette =
+      mandelbrot::colour::palette::build<MAX_ITER>(mandelbrot::colour::scheme::classic);
+  mandelbrot::colour::shade<MAX_ITER>(
+      map, 1, palette, true, pool->get_scheduler(), state.range(2), encode_image
+  );
+}
+static void EncodeTeardown(const benchmark::State &state) {
+  pool.reset();
+  encode_image = {};
+}
+
+static void BM_Encode(benchmark::State &state) {
+  auto const qoi = state.range(0) != 0;
+  auto const parallel = state.range(1) != 0;
+  state.SetLabel(
+      std::format("Encode {} [{}]", qoi ? "QOI" : "PNG", parallel ? "parallel" : "serial")
+  );
+
+  auto scheduler = pool->get_scheduler();
+  auto bytes = std::vector<std::uint8_t>{};
+  for (auto _ : state) {
+    auto start = std::chrono::high_resolution_clock::now();
+    if (qoi) {
+      bytes = parallel ? mandelbrot::encode_qoi(encode_image, scheduler)
+                       : mandelbrot::encode_qoi(encode_image);
+    } else {
+      bytes = parallel ? mandelbrot::encode_png(encode_image, scheduler)
+                       : mandelbrot::encode_png(encode_image);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    state.SetIterationTime(elapsed_seconds.count());
+    benchmark::DoNotOptimize(bytes.data());
+    benchmark::ClobberMemory();
+  }
+  auto const pixels = double(encode_image.width * encode_image.height);
+  state.counters["pixels"] =
+      benchmark::Counter(pixels, benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["ratio"] = double(bytes.size()) / double(encode_image.pixels.size());
+}
+BENCHMARK(BM_Encode)
+    ->UseManualTime()
+    ->Setup(EncodeSetup)
+    ->Teardown(EncodeTeardown)
+    ->ArgsProduct({{0, 1}, {0, 1}, {THREAD_COUNT}});
+
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -16,6 +16,18 @@ class mandelbrotRecipe(ConanFile):
 
     # Binary configuration
     settings = "os", "compiler", "build_type", "arch"
+    options = {
+        "with_tbb": [True, False],
+        "with_libdispatch": [True, False],
+        "with_openmp": [True, False],
+        "with_viewer": [True, False],
+    }
+    default_options = {
+        "with_tbb": False,
+        "with_libdispatch": False,
+        "with_openmp": False,
+        "with_viewer": True,
+    }
 
     # Sources are located in the same place as this recipe, copy them to the recipe
     exports_sources = "CMakeLists.txt", "src/*"
@@ -26,12 +38,16 @@ class mandelbrotRecipe(ConanFile):
 
     def requirements(self):
         self.requires("xsimd/13.2.0")
-        #self.requires("libdispatch/5.3.2")
-        #self.requires("onetbb/2022.0.0")
-        self.requires("sfml/2.6.1", options={
-            "network": False,
-            "audio": False,
-        })
+        self.requires("zlib/1.3.1")
+        if self.options.with_libdispatch:
+            self.requires("libdispatch/5.3.2")
+        if self.options.with_tbb:
+            self.requires("onetbb/2022.0.0")
+        if self.options.with_viewer:
+            self.requires("sfml/2.6.1", options={
+                "network": False,
+                "audio": False,
+            })
 
     def configure(self):
         pass
@@ -43,6 +59,10 @@ class mandelbrotRecipe(ConanFile):
         deps = CMakeDeps(self)
         deps.generate()
         tc = CMakeToolchain(self)
+        tc.variables["MANDELBROT_WITH_TBB"] = bool(self.options.with_tbb)
+        tc.variables["MANDELBROT_WITH_LIBDISPATCH"] = bool(self.options.with_libdispatch)
+        tc.variables["MANDELBROT_WITH_OPENMP"] = bool(self.options.with_openmp)
+        tc.variables["MANDELBROT_BUILD_VIEWER"] = bool(self.options.with_viewer)
         tc.generate()
 
     def build(self):
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <xsimd/xsimd.hpp>
+
+#include "mandelbrot/colour.hpp"
+#include "mandelbrot/tile.hpp"
+
+namespace mandelbrot::tile {
+
+/// Neighbour contrast, in normalized colour coordinate units, above which a pixel is
+/// supersampled; roughly one 8-bit step of a linear palette.
+inline constexpr double ADAPTIVE_THRESHOLD = 1.0 / 256.0;
+
+/// `r` grown by `margin` pixels on every side, clipped to a width x height frame.
+[[nodiscard]] inline auto grow(rect r, std::size_t margin, std::size_t width, std::size_t height)
+    -> rect {
+  auto const x = r.x - std::min(r.x, margin);
+  auto const y = r.y - std::min(r.y, margin);
+  return {
+      x,
+      y,
+      std::min(width, r.x + r.width + margin) - x,
+      std::min(height, r.y + r.height + margin) - y
+  };
+}
+
+/// Adaptive supersampling. `centres` holds one sample per pixel of `vp` for `region` grown by
+/// one pixel; `map` is the frame's n x n sample grid (n = samples_per_side). Pixels whose colour
+/// coordinate differs from a 4-neighbour's by more than `threshold` get all n x n samples
+/// computed, the rest get their centre sample replicated. Returns the number of pixels refined.
+template <std::size_t MAX_ITER>
+auto refine_adaptive(
+    viewport const &vp,
+    iteration_map const &centres,
+    iteration_map &map,
+    std::size_t samples_per_side,
+    rect region,
+    auto scheduler,
+    bool smooth,
+    double threshold = ADAPTIVE_THRESHOLD
+) -> std::size_t {
+  using batch = xsimd::batch<double>;
+  constexpr auto lanes = batch::size;
+  auto const n = samples_per_side;
+  auto const fine = viewport{vp.center_x, vp.center_y, vp.zoom, vp.width * n, vp.height * n};
+  auto const area = grow(region, 1, vp.width, vp.height);
+
+  // Colour coordinate of every centre sample the contrast test looks at
+  auto t = std::vector<double>(area.area());
+  parallel_for(scheduler, area.height, [&](std::size_t row) {
+    alignas(alignof(batch)) double iter_buf[lanes];
+    alignas(alignof(batch)) double mag_buf[lanes];
+    alignas(alignof(batch)) double t_buf[lanes];
+    for (std::size_t x = 0; x < area.width; x += lanes) {
+      auto const valid = std::min(lanes, area.width - x);
+      for (std::size_t lane = 0; lane != lanes; ++lane) {
+        auto const idx = centres.index(area.x + x + std::min(lane, valid - 1), area.y + row);
+        iter_buf[lane] = static_cast<double>(centres.iter[idx]);
+        mag_buf[lane] = centres.mag[idx];
+      }
+      colour::normalized<MAX_ITER>(
+          batch::load_aligned(iter_buf), batch::load_aligned(mag_buf), smooth
+      )
+          .store_aligned(t_buf);
+      std::copy_n(t_buf, valid, t.begin() + row * area.width + x);
+    }
+  });
+
+  auto const [tiles_x, tiles_y] = tile_count(region);
+  auto refined = std::atomic<std::size_t>{0};
+  parallel_for(scheduler, tiles_x * tiles_y, [&](std::size_t i) {
+    auto const r = tile_bounds(region, i % tiles_x, i / tiles_x);
+    auto points = std::vector<std::size_t>{};
+    for (auto y = r.y; y != r.y + r.height; ++y) {
+      for (auto x = r.x; x != r.x + r.width; ++x) {
+        auto const at = [&](std::size_t px, std::size_t py) {
+          return t[(py - area.y) * area.width + (px - area.x)];
+        };
+        auto const centre = at(x, y);
+        auto const differs = [&](std::size_t px, std::size_t py) {
+          return std::abs(at(px, py) - centre) > threshold;
+        };
+        auto const edge = (x > area.x and differs(x - 1, y)) or
+                          (x + 1 < area.x + area.width and differs(x + 1, y)) or
+                          (y > area.y and differs(x, y - 1)) or
+                          (y + 1 < area.y + area.height and differs(x, y + 1));
+
+        auto const src = centres.index(x, y);
+        for (std::size_t sy = 0; sy != n; ++sy) {
+          auto const row = map.index(x * n, y * n + sy);
+          if (edge) {
+            for (std::size_t sx = 0; sx != n; ++sx) {
+              points.push_back(row + sx);
+            }
+          } else {
+            std::fill_n(map.iter.begin() + row, n, centres.iter[src]);
+            std::fill_n(map.mag.begin() + row, n, centres.mag[src]);
+            map.forget_orbits(row, row + n);
+          }
+        }
+      }
+    }
+    compute_points<MAX_ITER>(fine, map, points);
+    refined.fetch_add(points.size() / (n * n), std::memory_order_relaxed);
+  });
+  return refined.load();
+}
+
+} // namespace mandelbrot::tile
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include <exec/static_thread_pool.hpp>
+#include <stdexec/execution.hpp>
+
+#ifndef MANDELBROT_HAS_TBB
+#define MANDELBROT_HAS_TBB 0
+#endif
+#ifndef MANDELBROT_HAS_LIBDISPATCH
+#define MANDELBROT_HAS_LIBDISPATCH 0
+#endif
+#ifndef MANDELBROT_HAS_OPENMP
+#define MANDELBROT_HAS_OPENMP 0
+#endif
+
+#if MANDELBROT_HAS_TBB
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
+#include <oneapi/tbb/partitioner.h>
+#include <oneapi/tbb/task_arena.h>
+#endif
+#if MANDELBROT_HAS_LIBDISPATCH
+#include <dispatch/dispatch.h>
+#endif
+
+namespace mandelbrot {
+
+// Backends other than stdexec are opt-in at build time (MANDELBROT_WITH_* in CMake)
+enum class backend : int { stdexec = 0, tbb, libdispatch, openmp, count };
+
+[[nodiscard]] constexpr auto to_string(backend b) -> std::string_view {
+  switch (b) {
+  case backend::stdexec: return "stdexec";
+  case backend::tbb: return "TBB";
+  case backend::libdispatch: return "libdispatch";
+  case backend::openmp: return "OpenMP";
+  case backend::count: break;
+  }
+  return "Unknown";
+}
+
+[[nodiscard]] constexpr auto available(backend b) -> bool {
+  switch (b) {
+  case backend::stdexec: return true;
+  case backend::tbb: return MANDELBROT_HAS_TBB != 0;
+  case backend::libdispatch: return MANDELBROT_HAS_LIBDISPATCH != 0;
+  case backend::openmp: return MANDELBROT_HAS_OPENMP != 0;
+  case backend::count: break;
+  }
+  return false;
+}
+
+class backend_pool;
+
+/// Lightweight, copyable handle selecting a backend at run time.
+struct backend_scheduler {
+  backend kind = backend::stdexec;
+  std::size_t threads = 1;
+  backend_pool *pool = nullptr;
+};
+
+/// Owns the worker threads of every enabled backend. libdispatch uses its global queue and
+/// sizes itself; the others are pinned to `threads` workers.
+class backend_pool {
+public:
+  explicit backend_pool(std::size_t threads)
+      : threads_(std::max<std::size_t>(threads, 1)),
+        stdexec_pool_(static_cast<std::uint32_t>(threads_))
+#if MANDELBROT_HAS_TBB
+        ,
+        arena_(static_cast<int>(threads_))
+#endif
+  {
+  }
+
+  [[nodiscard]] auto get_scheduler(backend kind = backend::stdexec) -> backend_scheduler {
+    return {available(kind) ? kind : backend::stdexec, threads_, this};
+  }
+  [[nodiscard]] auto available_parallelism() const -> std::size_t { return threads_; }
+  [[nodiscard]] auto stdexec_scheduler() { return stdexec_pool_.get_scheduler(); }
+#if MANDELBROT_HAS_TBB
+  [[nodiscard]] auto arena() -> tbb::task_arena & { return arena_; }
+#endif
+
+private:
+  std::size_t threads_;
+  exec::static_thread_pool stdexec_pool_;
+#if MANDELBROT_HAS_TBB
+  tbb::task_arena arena_;
+#endif
+};
+
+/// Runs f(i) for every i in [0, n) on the scheduler's workers and waits for completion.
+template <stdexec::scheduler Scheduler>
+void parallel_for(Scheduler scheduler, std::size_t n, auto &&f) {
+  stdexec::sync_wait(stdexec::bulk(stdexec::schedule(scheduler), stdexec::par, n, f));
+}
+
+void parallel_for(backend_scheduler const &scheduler, std::size_t n, auto &&f) {
+  switch (scheduler.kind) {
+#if MANDELBROT_HAS_TBB
+  case backend::tbb:
+    scheduler.pool->arena().execute([&] {
+      tbb::parallel_for(
+          tbb::blocked_range<std::size_t>(0, n),
+          [&](tbb::blocked_range<std::size_t> const &range) {
+            for (auto i = range.begin(); i != range.end(); ++i) {
+              f(i);
+            }
+          },
+          tbb::auto_partitioner{}
+      );
+    });
+    return;
+#endif
+#if MANDELBROT_HAS_LIBDISPATCH
+  case backend::libdispatch: {
+    using body_t = std::remove_reference_t<decltype(f)>;
+    dispatch_apply_f(
+        n,
+        dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0),
+        static_cast<void *>(&f),
+        [](void *context, std::size_t i) { (*static_cast<body_t *>(context))(i); }
+    );
+    return;
+  }
+#endif
+#if MANDELBROT_HAS_OPENMP
+  case backend::openmp: {
+    auto const count = static_cast<std::ptrdiff_t>(n);
+#pragma omp parallel for schedule(dynamic) num_threads(static_cast<int>(scheduler.threads))
+    for (std::ptrdiff_t i = 0; i < count; ++i) {
+      f(static_cast<std::size_t>(i));
+    }
+    return;
+  }
+#endif
+  default:
+    parallel_for(scheduler.pool->stdexec_scheduler(), n, f);
+    return;
+  }
+}
+
+/// Scheduler for work already running on a worker, such as a per-tile callback: everything runs
+/// in order on the calling thread.
+struct inline_scheduler {};
+
+void parallel_for(inline_scheduler, std::size_t n, auto &&f) {
+  for (std::size_t i = 0; i != n; ++i) {
+    f(i);
+  }
+}
+
+/// Runs f(begin, end) over contiguous chunks of [0, n), a few chunks per worker.
+void parallel_for_chunked(auto scheduler, std::size_t n, std::size_t workers, auto &&f) {
+  auto const chunks = std::min(n, std::max<std::size_t>(workers, 1) * 4);
+  parallel_for(scheduler, chunks, [&](std::size_t i) { f(i * n / chunks, (i + 1) * n / chunks); });
+}
+
+} // namespace mandelbrot
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include "mandelbrot/tile.hpp"
+
+namespace mandelbrot::tile {
+
+inline constexpr std::size_t COST_BLOCK = 8;
+
+/// Iteration cost of the last frame, kept at COST_BLOCK resolution so it can be reprojected
+/// onto the next viewport (a pan or zoom of the same scene costs nearly the same per area).
+class cost_model {
+public:
+  /// Records per-pixel cost (e.g. iteration counts) of a finished frame of `vp`. A `stride` above
+  /// 1 reads only every stride-th pixel across and down each block, for callers that record
+  /// every frame.
+  void record(
+      viewport const &vp, std::span<std::size_t const> pixel_cost, std::size_t stride = 1
+  ) {
+    vp_ = vp;
+    auto const [blocks_x, blocks_y] = tile_count(vp, COST_BLOCK);
+    blocks_x_ = blocks_x;
+    block_cost_.assign(blocks_x * blocks_y, 0.0);
+
+    // Samples sit mid-stride and are clamped into edge blocks, so every block gets at least one
+    auto total = 0.0;
+    for (std::size_t b = 0; b != block_cost_.size(); ++b) {
+      auto const r = tile_bounds(vp, b % blocks_x, b / blocks_x, COST_BLOCK);
+      auto sum = 0.0;
+      auto samples = 0uz;
+      for (auto y = r.y + stride / 2; y < r.y + r.height + stride / 2; y += stride) {
+        auto const row = std::min(y, r.y + r.height - 1) * vp.width;
+        for (auto x = r.x + stride / 2; x < r.x + r.width + stride / 2; x += stride) {
+          sum += static_cast<double>(pixel_cost[row + std::min(x, r.x + r.width - 1)]);
+          ++samples;
+        }
+      }
+      block_cost_[b] = sum / static_cast<double>(samples);
+      total += block_cost_[b] * static_cast<double>(r.area());
+    }
+    mean_ = total / static_cast<double>(vp.width * vp.height);
+  }
+
+  [[nodiscard]] auto empty() const -> bool { return block_cost_.empty(); }
+
+  /// Predicted cost of the pixel at (px, py) of `vp`; areas not seen last frame get the mean.
+  [[nodiscard]] auto sample(viewport const &vp, double px, double py) const -> double {
+    auto const ox = (vp.real(px) - vp_.center_x) / vp_.scale() + vp_.width / 2.0;
+    auto const oy = (vp_.center_y - vp.imag(py)) / vp_.scale() + vp_.height / 2.0;
+    if (ox < 0.0 or oy < 0.0 or ox >= vp_.width or oy >= vp_.height) {
+      return mean_;
+    }
+    auto const bx = static_cast<std::size_t>(ox) / COST_BLOCK;
+    auto const by = static_cast<std::size_t>(oy) / COST_BLOCK;
+    return block_cost_[by * blocks_x_ + bx];
+  }
+
+  /// Predicted cost of each tile of `vp` (row-major, `tile_size` square), sampled every
+  /// COST_BLOCK pixels.
+  [[nodiscard]] auto predict(viewport const &vp, std::size_t tile_size = COST_BLOCK) const
+      -> std::vector<double> {
+    auto const [tiles_x, tiles_y] = tile_count(vp, tile_size);
+    auto costs = std::vector<double>(tiles_x * tiles_y);
+    for (std::size_t t = 0; t != costs.size(); ++t) {
+      auto const r = tile_bounds(vp, t % tiles_x, t / tiles_x, tile_size);
+      auto sum = 0.0;
+      auto samples = 0uz;
+      for (auto y = r.y + COST_BLOCK / 2; y < r.y + r.height + COST_BLOCK / 2; y += COST_BLOCK) {
+        for (auto x = r.x + COST_BLOCK / 2; x < r.x + r.width + COST_BLOCK / 2; x += COST_BLOCK) {
+          sum += sample(vp, std::min(x, r.x + r.width - 1), std::min(y, r.y + r.height - 1));
+          ++samples;
+        }
+      }
+      costs[t] = sum / static_cast<double>(samples) * static_cast<double>(r.area());
+    }
+    return costs;
+  }
+
+  /// Predicted cost of each pixel row of `vp`.
+  [[nodiscard]] auto predict_rows(viewport const &vp) const -> std::vector<double> {
+    auto const tiles = predict(vp);
+    auto const tiles_x = tile_count(vp, COST_BLOCK).first;
+    auto rows = std::vector<double>(vp.height);
+    for (std::size_t y = 0; y != vp.height; ++y) {
+      auto const ty = y / COST_BLOCK;
+      auto const tile_rows = static_cast<double>(tile_bounds(vp, 0, ty, COST_BLOCK).height);
+      for (std::size_t tx = 0; tx != tiles_x; ++tx) {
+        rows[y] += tiles[ty * tiles_x + tx] / tile_rows;
+      }
+    }
+    return rows;
+  }
+
+private:
+  viewport vp_{};
+  std::size_t blocks_x_{};
+  std::vector<double> block_cost_;
+  double mean_{};
+};
+
+/// Splits [0, costs.size()) into `parts` contiguous ranges of roughly equal total cost;
+/// returns the parts + 1 range boundaries.
+[[nodiscard]] inline auto partition(std::span<double const> costs, std::size_t parts)
+    -> std::vector<std::size_t> {
+  auto const n = costs.size();
+  auto const total = std::accumulate(costs.begin(), costs.end(), 0.0);
+  auto bounds = std::vector<std::size_t>{0};
+  bounds.reserve(parts + 1);
+  if (total <= 0.0) {
+    for (std::size_t k = 1; k != parts; ++k) {
+      bounds.push_back(n * k / parts);
+    }
+  } else {
+    auto acc = 0.0;
+    for (std::size_t i = 0; i != n and bounds.size() < parts; ++i) {
+      acc += costs[i];
+      while (bounds.size() < parts and acc >= total * bounds.size() / parts) {
+        bounds.push_back(i + 1);
+      }
+    }
+  }
+  while (bounds.size() <= parts) {
+    bounds.push_back(n);
+  }
+  return bounds;
+}
+
+struct load_report {
+  double wall_seconds{};
+  double idle_fraction{}; // share of worker time spent waiting for the slowest range
+};
+
+/// Runs `f(begin, end)` for each range in `bounds`, one range per work item, and reports how
+/// long the workers sat idle. Pass one range per pool thread for a meaningful idle figure.
+auto run_partitioned(auto scheduler, std::span<std::size_t const> bounds, auto &&f)
+    -> load_report {
+  using clock = std::chrono::steady_clock;
+  using seconds = std::chrono::duration<double>;
+
+  auto const parts = bounds.size() - 1;
+  auto busy = std::vector<double>(parts);
+  auto const start = clock::now();
+  parallel_for(scheduler, parts, [&](std::size_t i) {
+    auto const t0 = clock::now();
+    f(bounds[i], bounds[i + 1]);
+    busy[i] = seconds(clock::now() - t0).count();
+  });
+  auto const wall = seconds(clock::now() - start).count();
+
+  auto const busy_total = std::accumulate(busy.begin(), busy.end(), 0.0);
+  auto const capacity = wall * static_cast<double>(parts);
+  return {wall, capacity > 0.0 ? std::max(0.0, 1.0 - busy_total / capacity) : 0.0};
+}
+
+/// Brute-force render with one contiguous band of rows per worker. With a `model` holding a
+/// previous frame the bands carry equal predicted cost, otherwise equal pixel counts; the
+/// model then records the new frame.
+template <std::size_t MAX_ITER>
+auto render_balanced(
+    viewport const &vp,
+    iteration_map &map,
+    auto scheduler,
+    std::size_t workers,
+    cost_model *model
+) -> load_report {
+  map.resize(vp.width, vp.height);
+
+  auto const costs = (model != nullptr and not model->empty())
+                         ? model->predict_rows(vp)
+                         : std::vector<double>(vp.height, 1.0);
+  auto const bounds = partition(costs, workers);
+
+  auto const report = run_partitioned(scheduler, bounds, [&](std::size_t begin, std::size_t end) {
+    for (auto y = begin; y != end; ++y) {
+      compute_line<MAX_ITER>(vp, map, 0, y, 1, 0, vp.width);
+    }
+  });
+
+  if (model != nullptr) {
+    model->record(vp, map.iter);
+  }
+  return report;
+}
+
+} // namespace mandelbrot::tile
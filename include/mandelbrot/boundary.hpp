@@ -0,0 +1,203 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "mandelbrot/tile.hpp"
+
+namespace mandelbrot::tile {
+
+namespace {
+
+/// Grid lines every `tile_size` pixels plus the last pixel; neighbouring cells share them.
+[[nodiscard]] inline auto seam_positions(std::size_t extent, std::size_t tile_size)
+    -> std::vector<std::size_t> {
+  auto seams = std::vector<std::size_t>{};
+  for (std::size_t p = 0; p + 1 < extent; p += tile_size) {
+    seams.push_back(p);
+  }
+  seams.push_back(extent - 1);
+  return seams;
+}
+
+/// Traces the band edges inside a cell whose border is already computed, then fills the
+/// enclosed areas (only those inside the set under fill_mode::interior; the rest are iterated).
+/// Returns the number of pixels iterated.
+template <std::size_t MAX_ITER>
+auto trace_cell(viewport const &vp, iteration_map &map, rect r, fill_mode fill) -> std::size_t {
+  if (r.width <= 2 or r.height <= 2) {
+    return 0;
+  }
+
+  enum : std::uint8_t { LOADED = 1, QUEUED = 2 };
+  auto state = std::vector<std::uint8_t>(r.area());
+  auto queue = std::vector<std::size_t>{};
+  auto pending = std::vector<std::size_t>{};
+  auto computed = std::size_t{};
+
+  auto const global = [&](std::size_t l) {
+    return map.index(r.x + l % r.width, r.y + l / r.width);
+  };
+  auto const enqueue = [&](std::size_t l) {
+    if (not(state[l] & QUEUED)) {
+      state[l] |= QUEUED;
+      queue.push_back(l);
+    }
+  };
+  auto const request = [&](std::size_t l) {
+    if (not(state[l] & LOADED)) {
+      state[l] |= LOADED;
+      pending.push_back(global(l));
+    }
+  };
+
+  // The border is seam data: already loaded, and the seed of every trace
+  for (std::size_t lx = 0; lx != r.width; ++lx) {
+    for (auto const l : {lx, (r.height - 1) * r.width + lx}) {
+      state[l] = LOADED;
+      enqueue(l);
+    }
+  }
+  for (std::size_t ly = 1; ly + 1 < r.height; ++ly) {
+    for (auto const l : {ly * r.width, ly * r.width + r.width - 1}) {
+      state[l] = LOADED;
+      enqueue(l);
+    }
+  }
+
+  while (not queue.empty()) {
+    auto const l = queue.back();
+    queue.pop_back();
+
+    auto const lx = l % r.width;
+    auto const ly = l / r.width;
+    auto const has_l = lx > 0;
+    auto const has_r = lx + 1 < r.width;
+    auto const has_u = ly > 0;
+    auto const has_d = ly + 1 < r.height;
+
+    // The pixel and its neighbours not loaded yet, up to five points, go to compute_points
+    // together; it splits them into SIMD batches, so five new points take two four-lane batches
+    pending.clear();
+    request(l);
+    if (has_l) request(l - 1);
+    if (has_r) request(l + 1);
+    if (has_u) request(l - r.width);
+    if (has_d) request(l + r.width);
+    if (not pending.empty()) {
+      compute_points<MAX_ITER>(vp, map, pending);
+      computed += pending.size();
+    }
+
+    auto const centre = map.iter[global(l)];
+    auto const differs = [&](std::size_t n) { return map.iter[global(n)] != centre; };
+    auto const edge_l = has_l and differs(l - 1);
+    auto const edge_r = has_r and differs(l + 1);
+    auto const edge_u = has_u and differs(l - r.width);
+    auto const edge_d = has_d and differs(l + r.width);
+
+    // Follow the band edge: neighbours across it, and diagonals along it
+    if (edge_l) enqueue(l - 1);
+    if (edge_r) enqueue(l + 1);
+    if (edge_u) enqueue(l - r.width);
+    if (edge_d) enqueue(l + r.width);
+    if (has_u and has_l and (edge_l or edge_u)) enqueue(l - r.width - 1);
+    if (has_u and has_r and (edge_r or edge_u)) enqueue(l - r.width + 1);
+    if (has_d and has_l and (edge_l or edge_d)) enqueue(l + r.width - 1);
+    if (has_d and has_r and (edge_r or edge_d)) enqueue(l + r.width + 1);
+  }
+
+  // Everything not loaded is enclosed by a traced edge of its left neighbour's band. A band the
+  // fill mode excludes is still copied along, so the row knows which band it is in, then iterated.
+  pending.clear();
+  for (std::size_t ly = 1; ly + 1 < r.height; ++ly) {
+    for (std::size_t lx = 1; lx + 1 < r.width; ++lx) {
+      auto const l = ly * r.width + lx;
+      if (not(state[l] & LOADED)) {
+        map.iter[global(l)] = map.iter[global(l - 1)];
+        map.mag[global(l)] = map.mag[global(l - 1)];
+        map.forget_orbits(global(l), global(l) + 1);
+        if (fill == fill_mode::interior and map.iter[global(l)] < MAX_ITER) {
+          pending.push_back(global(l));
+        }
+      }
+    }
+  }
+  if (not pending.empty()) {
+    compute_points<MAX_ITER>(vp, map, pending);
+    computed += pending.size();
+  }
+  return computed;
+}
+
+} // namespace
+
+/// Boundary tracing: compute only the pixels on iteration band edges and fill the enclosed
+/// areas. Seam lines are computed once up front, then cells are traced in parallel with the
+/// seams as their shared, read-only borders. Only `region` is rendered; returns the number of
+/// pixels actually iterated. `fill` limits which areas are filled. Each finished cell goes to
+/// `on_tile` without its right and bottom seams, which the next cells report, so every pixel is
+/// reported once.
+template <std::size_t MAX_ITER, typename OnTile = ignore_tile>
+auto render_boundary_trace(
+    viewport const &vp,
+    iteration_map &map,
+    auto scheduler,
+    rect region,
+    fill_mode fill = fill_mode::bands,
+    OnTile on_tile = {}
+) -> std::size_t {
+  if (region.width < 3 or region.height < 3) {
+    return render_brute_force<MAX_ITER>(vp, map, scheduler, region, on_tile);
+  }
+
+  auto seams_x = seam_positions(region.width, TILE_SIZE);
+  auto seams_y = seam_positions(region.height, TILE_SIZE);
+  for (auto &x : seams_x) {
+    x += region.x;
+  }
+  for (auto &y : seams_y) {
+    y += region.y;
+  }
+
+  // Seam rows span the full width; seam columns fill the gaps between seam rows
+  parallel_for(scheduler, seams_y.size() + seams_x.size(), [&](std::size_t i) {
+    if (i < seams_y.size()) {
+      compute_line<MAX_ITER>(vp, map, region.x, seams_y[i], 1, 0, region.width);
+      return;
+    }
+    auto const x = seams_x[i - seams_y.size()];
+    for (std::size_t k = 0; k + 1 < seams_y.size(); ++k) {
+      compute_line<MAX_ITER>(vp, map, x, seams_y[k] + 1, 0, 1, seams_y[k + 1] - seams_y[k] - 1);
+    }
+  });
+  auto computed = std::atomic<std::size_t>{
+      seams_y.size() * region.width + seams_x.size() * (region.height - seams_y.size())
+  };
+
+  auto const cells_x = seams_x.size() - 1;
+  auto const cells_y = seams_y.size() - 1;
+  parallel_for(scheduler, cells_x * cells_y, [&](std::size_t i) {
+    auto const cx = i % cells_x;
+    auto const cy = i / cells_x;
+    auto const cell = rect{
+        seams_x[cx],
+        seams_y[cy],
+        seams_x[cx + 1] - seams_x[cx] + 1,
+        seams_y[cy + 1] - seams_y[cy] + 1
+    };
+    computed.fetch_add(trace_cell<MAX_ITER>(vp, map, cell, fill), std::memory_order_relaxed);
+    on_tile(rect{
+        cell.x,
+        cell.y,
+        cell.width - (cx + 1 != cells_x ? 1 : 0),
+        cell.height - (cy + 1 != cells_y ? 1 : 0)
+    });
+  });
+
+  return computed.load();
+}
+
+} // namespace mandelbrot::tile
@@ -0,0 +1,291 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "mandelbrot/tile.hpp"
+
+namespace mandelbrot::tile {
+
+/// Side of a level-0 world tile in the complex plane; each level halves it.
+inline constexpr double WORLD_TILE_SPAN = 4.0;
+
+/// Everything that determines the samples of one world tile.
+struct tile_key {
+  int level{};
+  std::int64_t x{};
+  std::int64_t y{};
+  std::size_t max_iter{};
+  std::uint32_t formula{}; // Iteration variant; 0 is z^2 + c, the only one so far
+  std::uint32_t samples_per_side = 1;
+
+  [[nodiscard]] auto operator==(tile_key const &) const -> bool = default;
+};
+
+struct tile_key_hash {
+  [[nodiscard]] auto operator()(tile_key const &k) const noexcept -> std::size_t {
+    auto h = std::hash<std::int64_t>{}(k.x);
+    auto const mix = [&](std::size_t v) { h ^= v + 0x9e3779b97f4a7c15 + (h << 6) + (h >> 2); };
+    mix(std::hash<std::int64_t>{}(k.y));
+    mix(static_cast<std::size_t>(k.level));
+    mix(k.max_iter);
+    mix(k.formula);
+    mix(k.samples_per_side);
+    return h;
+  }
+};
+
+/// Samples of one world tile: TILE_SIZE x TILE_SIZE pixels of n x n samples each.
+using tile_data = std::shared_ptr<iteration_map const>;
+
+/// Slower storage behind a tile_cache: consulted on misses and given every new tile.
+class tile_backing {
+public:
+  virtual ~tile_backing() = default;
+  [[nodiscard]] virtual auto load(tile_key const &key) -> tile_data = 0;
+  virtual void save(tile_key const &key, tile_data tile) = 0;
+};
+
+/// Memory-bounded cache of world tiles with least-recently-used eviction. Thread-safe.
+class tile_cache {
+public:
+  explicit tile_cache(std::size_t capacity_bytes) : capacity_(capacity_bytes) {}
+
+  /// Tiles missing from memory are looked up in `backing` (if not null), which also receives
+  /// every inserted tile. It must outlive the cache.
+  void set_backing(tile_backing *backing) {
+    auto const lock = std::lock_guard{mutex_};
+    backing_ = backing;
+  }
+
+  /// The tile for `key`, or null on a miss.
+  [[nodiscard]] auto find(tile_key const &key) -> tile_data {
+    auto backing = static_cast<tile_backing *>(nullptr);
+    {
+      auto const lock = std::lock_guard{mutex_};
+      if (auto const it = index_.find(key); it != index_.end()) {
+        ++hits_;
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return it->second->second;
+      }
+      backing = backing_;
+    }
+    auto data = backing != nullptr ? backing->load(key) : nullptr;
+    auto const lock = std::lock_guard{mutex_};
+    if (data == nullptr) {
+      ++misses_;
+      return nullptr;
+    }
+    ++hits_;
+    ++backing_hits_;
+    insert_locked(key, data);
+    return data;
+  }
+
+  /// The tile for `key` if it is in memory, leaving the statistics and the LRU order alone.
+  [[nodiscard]] auto peek(tile_key const &key) const -> tile_data {
+    auto const lock = std::lock_guard{mutex_};
+    auto const it = index_.find(key);
+    return it != index_.end() ? it->second->second : nullptr;
+  }
+
+  void insert(tile_key const &key, tile_data data) {
+    auto backing = static_cast<tile_backing *>(nullptr);
+    {
+      auto const lock = std::lock_guard{mutex_};
+      insert_locked(key, data);
+      backing = backing_;
+    }
+    if (backing != nullptr) {
+      backing->save(key, std::move(data));
+    }
+  }
+
+  void clear() {
+    auto const lock = std::lock_guard{mutex_};
+    lru_.clear();
+    index_.clear();
+    size_ = 0;
+  }
+
+  [[nodiscard]] auto size_bytes() const -> std::size_t {
+    auto const lock = std::lock_guard{mutex_};
+    return size_;
+  }
+  [[nodiscard]] auto hits() const -> std::size_t {
+    auto const lock = std::lock_guard{mutex_};
+    return hits_;
+  }
+  /// Hits served by the backing store rather than memory.
+  [[nodiscard]] auto backing_hits() const -> std::size_t {
+    auto const lock = std::lock_guard{mutex_};
+    return backing_hits_;
+  }
+  [[nodiscard]] auto misses() const -> std::size_t {
+    auto const lock = std::lock_guard{mutex_};
+    return misses_;
+  }
+  [[nodiscard]] auto hit_rate() const -> double {
+    auto const lock = std::lock_guard{mutex_};
+    auto const lookups = hits_ + misses_;
+    return lookups == 0 ? 0.0 : static_cast<double>(hits_) / static_cast<double>(lookups);
+  }
+  void reset_stats() {
+    auto const lock = std::lock_guard{mutex_};
+    hits_ = 0;
+    backing_hits_ = 0;
+    misses_ = 0;
+  }
+
+private:
+  using entry = std::pair<tile_key, tile_data>;
+
+  [[nodiscard]] static auto bytes(iteration_map const &m) -> std::size_t {
+    return m.iter.size() * sizeof(std::size_t) + m.mag.size() * sizeof(double);
+  }
+
+  void insert_locked(tile_key const &key, tile_data data) {
+    if (auto const it = index_.find(key); it != index_.end()) {
+      size_ -= bytes(*it->second->second);
+      lru_.erase(it->second);
+      index_.erase(it);
+    }
+    size_ += bytes(*data);
+    lru_.emplace_front(key, std::move(data));
+    index_.emplace(key, lru_.begin());
+    while (size_ > capacity_ and lru_.size() > 1) {
+      size_ -= bytes(*lru_.back().second);
+      index_.erase(lru_.back().first);
+      lru_.pop_back();
+    }
+  }
+
+  mutable std::mutex mutex_;
+  std::size_t capacity_;
+  std::size_t size_{};
+  std::size_t hits_{};
+  std::size_t backing_hits_{};
+  std::size_t misses_{};
+  tile_backing *backing_ = nullptr;
+  std::list<entry> lru_;
+  std::unordered_map<tile_key, std::list<entry>::iterator, tile_key_hash> index_;
+};
+
+/// Coarsest world tile level whose pixels are no larger than those of `vp`.
+[[nodiscard]] inline auto world_level(viewport const &vp) -> int {
+  return static_cast<int>(std::ceil(std::log2(WORLD_TILE_SPAN / (TILE_SIZE * vp.scale()))));
+}
+
+/// Distance between neighbouring samples of a world tile.
+[[nodiscard]] inline auto world_sample_pitch(int level, std::size_t samples_per_side) -> double {
+  return std::ldexp(WORLD_TILE_SPAN, -level) / static_cast<double>(TILE_SIZE * samples_per_side);
+}
+
+/// Viewport whose pixels are the samples of world tile `key`.
+[[nodiscard]] inline auto world_tile_viewport(tile_key const &key) -> viewport {
+  auto const side = TILE_SIZE * key.samples_per_side;
+  auto const pitch = world_sample_pitch(key.level, key.samples_per_side);
+  auto const half = static_cast<double>(side) / 2.0;
+  return {
+      (static_cast<double>(key.x * static_cast<std::int64_t>(side)) + half) * pitch,
+      -(static_cast<double>(key.y * static_cast<std::int64_t>(side)) + half) * pitch,
+      VIEWPORT_SCALE / (pitch * static_cast<double>(side)),
+      side,
+      side
+  };
+}
+
+/// Fills the n x n sample grid of `region` (pixels of `vp`) in an already sized `map` from world
+/// tiles at the level matching `vp`, computing only the tiles missing from `cache`. Samples are
+/// taken from the nearest world tile sample, so the result is a resampling of the tile grid.
+/// Returns the number of tiles computed.
+template <std::size_t MAX_ITER>
+auto render_cached(
+    viewport const &vp,
+    iteration_map &map,
+    std::size_t samples_per_side,
+    rect region,
+    auto scheduler,
+    tile_cache &cache
+) -> std::size_t {
+  auto const n = samples_per_side;
+  auto const fine = viewport{vp.center_x, vp.center_y, vp.zoom, vp.width * n, vp.height * n};
+  auto const level = world_level(vp);
+  auto const pitch = world_sample_pitch(level, n);
+  auto const side = static_cast<std::int64_t>(TILE_SIZE * n);
+
+  auto const grid_x = [&](std::size_t x) {
+    return static_cast<std::int64_t>(std::floor(fine.real(static_cast<double>(x) + 0.5) / pitch));
+  };
+  auto const grid_y = [&](std::size_t y) {
+    return static_cast<std::int64_t>(std::floor(-fine.imag(static_cast<double>(y) + 0.5) / pitch));
+  };
+  auto const tile_of = [&](std::int64_t g) { return g >= 0 ? g / side : -((side - 1 - g) / side); };
+
+  auto const x_begin = region.x * n;
+  auto const x_end = (region.x + region.width) * n;
+  auto const y_begin = region.y * n;
+  auto const y_end = (region.y + region.height) * n;
+  auto const tx0 = tile_of(grid_x(x_begin));
+  auto const ty0 = tile_of(grid_y(y_begin));
+  auto const tiles_x = static_cast<std::size_t>(tile_of(grid_x(x_end - 1)) - tx0 + 1);
+  auto const tiles_y = static_cast<std::size_t>(tile_of(grid_y(y_end - 1)) - ty0 + 1);
+
+  // Look everything up first; tiles stay alive through `tiles` even if evicted meanwhile
+  auto const key_of = [&](std::size_t i) {
+    return tile_key{
+        level,
+        tx0 + static_cast<std::int64_t>(i % tiles_x),
+        ty0 + static_cast<std::int64_t>(i / tiles_x),
+        MAX_ITER,
+        0,
+        static_cast<std::uint32_t>(n)
+    };
+  };
+  auto tiles = std::vector<tile_data>(tiles_x * tiles_y);
+  auto missing = std::vector<std::size_t>{};
+  for (std::size_t i = 0; i != tiles.size(); ++i) {
+    tiles[i] = cache.find(key_of(i));
+    if (tiles[i] == nullptr) {
+      missing.push_back(i);
+    }
+  }
+
+  parallel_for(scheduler, missing.size(), [&](std::size_t m) {
+    auto const key = key_of(missing[m]);
+    auto data = std::make_shared<iteration_map>();
+    data->resize(TILE_SIZE * n, TILE_SIZE * n);
+    render_rect<MAX_ITER>(world_tile_viewport(key), *data, {0, 0, data->width, data->height});
+    cache.insert(key, data);
+    tiles[missing[m]] = std::move(data);
+  });
+
+  parallel_for(scheduler, y_end - y_begin, [&](std::size_t row) {
+    auto const y = y_begin + row;
+    auto const gy = grid_y(y);
+    auto const ty = tile_of(gy);
+    auto const sy = static_cast<std::size_t>(gy - ty * side);
+    for (auto x = x_begin; x != x_end; ++x) {
+      auto const gx = grid_x(x);
+      auto const tx = tile_of(gx);
+      auto const &tile = *tiles[static_cast<std::size_t>(ty - ty0) * tiles_x +
+                                static_cast<std::size_t>(tx - tx0)];
+      auto const src = tile.index(static_cast<std::size_t>(gx - tx * side), sy);
+      auto const dst = map.index(x, y);
+      map.iter[dst] = tile.iter[src];
+      map.mag[dst] = tile.mag[src];
+    }
+    map.forget_orbits(map.index(x_begin, y), map.index(x_end, y));
+  });
+  return missing.size();
+}
+
+} // namespace mandelbrot::tile
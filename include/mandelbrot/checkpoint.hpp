@@ -0,0 +1,268 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace mandelbrot {
+
+namespace detail {
+
+inline constexpr std::uint64_t CHECKPOINT_MAGIC = 0x3154504B'43424D4DULL; // "MMBCKPT1"
+
+[[noreturn]] inline void throw_file_error(char const *what, std::filesystem::path const &path) {
+  throw std::system_error(errno, std::generic_category(), what + (' ' + path.string()));
+}
+
+struct checkpoint_header {
+  std::uint64_t magic;
+  std::uint64_t fingerprint;
+  std::uint64_t units;
+};
+
+} // namespace detail
+
+/// FNV-1a of a job description, to tell a checkpoint of this job from one of another.
+[[nodiscard]] inline auto fingerprint(std::string_view description) -> std::uint64_t {
+  auto h = std::uint64_t{0xcbf29ce484222325};
+  for (auto const c : description) {
+    h = (h ^ static_cast<unsigned char>(c)) * 0x100000001b3;
+  }
+  return h;
+}
+
+/// Output file of a fixed size written at offsets, so pieces can land in any order and a resumed
+/// job keeps what an earlier run wrote.
+class positioned_file {
+public:
+  positioned_file(std::filesystem::path const &path, std::size_t size, bool keep) : path_(path) {
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | (keep ? 0 : O_TRUNC), 0644);
+    if (fd_ < 0) {
+      detail::throw_file_error("cannot open", path_);
+    }
+    if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+      auto const error = errno;
+      ::close(fd_);
+      errno = error;
+      detail::throw_file_error("cannot size", path_);
+    }
+  }
+  positioned_file(positioned_file const &) = delete;
+  auto operator=(positioned_file const &) -> positioned_file & = delete;
+  ~positioned_file() { ::close(fd_); }
+
+  void write_at(std::uint64_t offset, std::span<std::byte const> bytes) {
+    while (not bytes.empty()) {
+      auto const written = ::pwrite(fd_, bytes.data(), bytes.size(), static_cast<off_t>(offset));
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        detail::throw_file_error("cannot write", path_);
+      }
+      bytes = bytes.subspan(static_cast<std::size_t>(written));
+      offset += static_cast<std::uint64_t>(written);
+    }
+  }
+
+  /// Waits until everything written so far is on disk.
+  void sync() {
+    if (::fdatasync(fd_) != 0) {
+      detail::throw_file_error("cannot sync", path_);
+    }
+  }
+
+private:
+  std::filesystem::path path_;
+  int fd_;
+};
+
+/// Which of a job's units are finished, kept in a file so that a restarted job can skip them.
+///
+/// mark() only sets a bit. A background thread saves at most once per interval, and only if
+/// something changed: it first syncs the output with `sync_output`, so a saved bit never stands
+/// for data that is not yet on disk, then replaces the checkpoint file atomically. A checkpoint
+/// of a different job (by fingerprint) or size is ignored.
+class checkpoint {
+public:
+  struct stats {
+    std::size_t saves{};
+    double total_seconds{};
+    double max_seconds{};
+  };
+
+  checkpoint(
+      std::filesystem::path const &path,
+      std::uint64_t fingerprint,
+      std::size_t units,
+      std::chrono::duration<double> interval,
+      std::function<void()> sync_output
+  )
+      : path_(path), fingerprint_(fingerprint), units_(units), interval_(interval),
+        sync_output_(std::move(sync_output)), bits_((units + 7) / 8) {
+    load();
+    saver_ = std::jthread([this](std::stop_token stop) {
+      while (true) {
+        {
+          auto lock = std::unique_lock{mutex_};
+          wake_.wait_for(lock, stop, interval_, [] { return false; });
+        }
+        if (stop.stop_requested()) {
+          return;
+        }
+        try {
+          save();
+        } catch (std::exception const &) {
+          // The previous checkpoint stays; the next interval tries again
+        }
+      }
+    });
+  }
+  checkpoint(checkpoint const &) = delete;
+  auto operator=(checkpoint const &) -> checkpoint & = delete;
+
+  /// An unfinished job (e.g. one unwinding from an error) saves what it has.
+  ~checkpoint() {
+    stop_saving();
+    if (not completed_) {
+      try {
+        save();
+      } catch (std::exception const &) {
+      }
+    }
+  }
+
+  [[nodiscard]] auto done(std::size_t unit) const -> bool {
+    auto const lock = std::lock_guard{mutex_};
+    return (bits_[unit / 8] >> (unit % 8) & 1) != 0;
+  }
+
+  [[nodiscard]] auto done_count() const -> std::size_t {
+    auto const lock = std::lock_guard{mutex_};
+    return done_;
+  }
+
+  /// Call once the unit's output has been written.
+  void mark(std::size_t unit) {
+    auto const lock = std::lock_guard{mutex_};
+    auto &byte = bits_[unit / 8];
+    auto const bit = static_cast<std::uint8_t>(1u << (unit % 8));
+    if ((byte & bit) == 0) {
+      byte |= bit;
+      ++done_;
+      ++version_;
+    }
+  }
+
+  /// The job is done: stops saving and removes the checkpoint file.
+  void complete() {
+    stop_saving();
+    completed_ = true;
+    std::filesystem::remove(path_);
+  }
+
+  [[nodiscard]] auto statistics() const -> stats {
+    auto const lock = std::lock_guard{mutex_};
+    return stats_;
+  }
+
+private:
+  void stop_saving() {
+    saver_.request_stop();
+    if (saver_.joinable()) {
+      saver_.join();
+    }
+  }
+
+  void load() {
+    auto in = std::ifstream(path_, std::ios::binary);
+    auto header = detail::checkpoint_header{};
+    auto bits = std::vector<std::uint8_t>(bits_.size());
+    in.read(reinterpret_cast<char *>(&header), sizeof(header));
+    in.read(reinterpret_cast<char *>(bits.data()), std::ssize(bits));
+    if (not in or header.magic != detail::CHECKPOINT_MAGIC or header.fingerprint != fingerprint_ or
+        header.units != units_) {
+      return;
+    }
+    bits_ = std::move(bits);
+    for (std::size_t unit = 0; unit != units_; ++unit) {
+      done_ += bits_[unit / 8] >> (unit % 8) & 1;
+    }
+  }
+
+  void save() {
+    auto lock = std::unique_lock{mutex_};
+    if (version_ == saved_version_) {
+      return;
+    }
+    auto const bits = bits_;
+    auto const version = version_;
+    lock.unlock();
+
+    auto const start = std::chrono::steady_clock::now();
+    sync_output_();
+    auto tmp = path_;
+    tmp += ".tmp";
+    auto const fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+      detail::throw_file_error("cannot open", tmp);
+    }
+    auto const header = detail::checkpoint_header{detail::CHECKPOINT_MAGIC, fingerprint_, units_};
+    auto record = std::vector<std::uint8_t>(sizeof(header) + bits.size());
+    std::memcpy(record.data(), &header, sizeof(header));
+    std::ranges::copy(bits, record.begin() + sizeof(header));
+    auto const ok = ::write(fd, record.data(), record.size()) == std::ssize(record) and
+                    ::fsync(fd) == 0;
+    auto const error = errno;
+    ::close(fd);
+    if (not ok) {
+      errno = error;
+      detail::throw_file_error("cannot write", tmp);
+    }
+    std::filesystem::rename(tmp, path_);
+    auto const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+    lock.lock();
+    saved_version_ = version;
+    ++stats_.saves;
+    stats_.total_seconds += elapsed.count();
+    stats_.max_seconds = std::max(stats_.max_seconds, elapsed.count());
+  }
+
+  std::filesystem::path path_;
+  std::uint64_t fingerprint_;
+  std::size_t units_;
+  std::chrono::duration<double> interval_;
+  std::function<void()> sync_output_;
+  mutable std::mutex mutex_;
+  std::condition_variable_any wake_;
+  std::vector<std::uint8_t> bits_;
+  std::size_t done_ = 0;
+  std::uint64_t version_ = 0;
+  std::uint64_t saved_version_ = 0;
+  stats stats_;
+  bool completed_ = false;
+  std::jthread saver_;
+};
+
+} // namespace mandelbrot
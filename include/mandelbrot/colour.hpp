@@ -0,0 +1,633 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <xsimd/xsimd.hpp>
+
+namespace mandelbrot::colour {
+
+using batch = xsimd::batch<double>;
+using rgb = std::tuple<batch, batch, batch>;
+
+enum class scheme : int {
+  classic = 0,
+  hot_iron,
+  electric_blue,
+  sunset,
+  grayscale,
+  blue_white,
+  exponential_lch,
+  rainbow_spiral,
+  ocean_depths,
+  lava_flow,
+  cherry_blossom,
+  neon_cyberpunk,
+  autumn_forest,
+  count
+};
+
+[[nodiscard]] constexpr auto to_string(scheme s) -> std::string_view {
+  switch (s) {
+  case scheme::classic: return "Ultra Fractal Classic";
+  case scheme::hot_iron: return "Hot Iron";
+  case scheme::electric_blue: return "Electric Blue";
+  case scheme::sunset: return "Sunset";
+  case scheme::grayscale: return "Grayscale";
+  case scheme::blue_white: return "Blue to White";
+  case scheme::exponential_lch: return "Exponential LCH";
+  case scheme::rainbow_spiral: return "Rainbow Spiral";
+  case scheme::ocean_depths: return "Ocean Depths";
+  case scheme::lava_flow: return "Lava Flow";
+  case scheme::cherry_blossom: return "Cherry Blossom";
+  case scheme::neon_cyberpunk: return "Neon Cyberpunk";
+  case scheme::autumn_forest: return "Autumn Forest";
+  case scheme::count: break;
+  }
+  return "Unknown";
+}
+
+namespace {
+
+[[nodiscard]] constexpr batch mix(const batch &a, const batch &b, const batch &f) noexcept {
+  return a + f * (b - a);
+}
+
+[[nodiscard]] batch lab_to_xyz(const batch &t) noexcept {
+  static constexpr double DELTA = 6.0 / 29.0;
+  static constexpr double DELTA_SQUARED_TIMES_3 = 3.0 * DELTA * DELTA;
+  static constexpr double OFFSET = 4.0 / 29.0;
+
+  const auto delta = batch(DELTA);
+  const auto cube = t * t * t;
+  const auto linear = batch(DELTA_SQUARED_TIMES_3) * (t - batch(OFFSET));
+  return select(t > delta, cube, linear);
+}
+
+[[nodiscard]] batch gamma_correct(const batch &c) noexcept {
+  static constexpr double LINEAR_FACTOR = 12.92;
+  static constexpr double GAMMA_FACTOR = 1.055;
+  static constexpr double GAMMA_POWER = 1.0 / 2.4;
+  static constexpr double GAMMA_OFFSET = 0.055;
+  static constexpr double THRESHOLD = 0.0031308;
+
+  const auto linear = batch(LINEAR_FACTOR) * c;
+  const auto gamma = batch(GAMMA_FACTOR) * xsimd::pow(c, batch(GAMMA_POWER)) - batch(GAMMA_OFFSET);
+  return select(c <= batch(THRESHOLD), linear, gamma);
+}
+
+
+[[nodiscard]] constexpr batch clamp_unit(const batch &value) noexcept {
+  return xsimd::min(batch(1.0), xsimd::max(batch(0.0), value));
+}
+
+template <std::size_t MAX_ITER>
+rgb exponential_lch(const batch &smooth_iterations) {
+  // SIMD implementation of Smooth Exponential LCH Color algorithm
+
+  // Handle max iterations (inside set) -> black
+  auto max_iter_mask = smooth_iterations >= batch(static_cast<double>(MAX_ITER));
+
+  // Calculate s parameter
+  auto s = smooth_iterations / batch(static_cast<double>(MAX_ITER));
+
+  // Calculate v parameter: v = 1.0 - cos²(π * s)
+  auto pi_s = s * batch(std::numbers::pi_v<double>);
+  auto cos_pi_s = xsimd::cos(pi_s);
+  auto v = batch(1.0) - cos_pi_s * cos_pi_s;
+
+  // Calculate LCH parameters
+  auto L = batch(75.0) - (batch(75.0) * v);
+  auto C = batch(28.0) + (batch(75.0) - (batch(75.0) * v));
+  auto H = xsimd::fmod(xsimd::pow(batch(360.0) * s, batch(1.5)), batch(360.0));
+
+  // Convert LCH to LAB
+  auto H_rad = H * batch(std::numbers::pi_v<double> / 180.0);
+  auto lab_a = C * xsimd::cos(H_rad);
+  auto lab_b = C * xsimd::sin(H_rad);
+
+  // Convert LAB to XYZ
+  auto fy = (L + batch(16.0)) / batch(116.0);
+  auto fx = lab_a / batch(500.0) + fy;
+  auto fz = fy - lab_b / batch(200.0);
+
+  auto X = batch(0.95047) * lab_to_xyz(fx);
+  auto Y = batch(1.00000) * lab_to_xyz(fy);
+  auto Z = batch(1.08883) * lab_to_xyz(fz);
+
+  // Convert XYZ to linear RGB
+  auto R_linear = batch(3.2406) * X - batch(1.5372) * Y - batch(0.4986) * Z;
+  auto G_linear = batch(-0.9689) * X + batch(1.8758) * Y + batch(0.0415) * Z;
+  auto B_linear = batch(0.0557) * X - batch(0.2040) * Y + batch(1.0570) * Z;
+
+  auto R_srgb = gamma_correct(R_linear);
+  auto G_srgb = gamma_correct(G_linear);
+  auto B_srgb = gamma_correct(B_linear);
+
+  // Clamp to [0, 1] range
+  auto r = xsimd::min(batch(1.0), xsimd::max(batch(0.0), R_srgb));
+  auto g = xsimd::min(batch(1.0), xsimd::max(batch(0.0), G_srgb));
+  auto b = xsimd::min(batch(1.0), xsimd::max(batch(0.0), B_srgb));
+
+  // Apply black for max iterations
+  r = select(max_iter_mask, batch(0.0), r);
+  g = select(max_iter_mask, batch(0.0), g);
+  b = select(max_iter_mask, batch(0.0), b);
+
+  return {r, g, b};
+}
+
+rgb classic(const batch &t) {
+  // Classic Ultra Fractal color scheme
+  const batch t0 = batch(0.16);
+  const batch t1 = batch(0.42);
+  const batch t2 = batch(0.6425);
+  const batch t3 = batch(0.8575);
+
+  // Color stops normalized to 0-1
+  const batch c0_r = batch(0.0), c0_g = batch(7.0 / 255.0), c0_b = batch(100.0 / 255.0);
+  const batch c1_r = batch(32.0 / 255.0), c1_g = batch(107.0 / 255.0),
+                c1_b = batch(203.0 / 255.0);
+  const batch c2_r = batch(237.0 / 255.0), c2_g = batch(1.0), c2_b = batch(1.0);
+  const batch c3_r = batch(1.0), c3_g = batch(170.0 / 255.0), c3_b = batch(0.0);
+  const batch c4_r = batch(0.0), c4_g = batch(2.0 / 255.0), c4_b = batch(0.0);
+  const batch c5_r = batch(0.0), c5_g = batch(7.0 / 255.0), c5_b = batch(100.0 / 255.0);
+
+  batch f01 = xsimd::min(batch(1.0), xsimd::max(batch(0.0), t / t0));
+  batch f12 = xsimd::min(batch(1.0), xsimd::max(batch(0.0), (t - t0) / (t1 - t0)));
+  batch f23 = xsimd::min(batch(1.0), xsimd::max(batch(0.0), (t - t1) / (t2 - t1)));
+  batch f34 = xsimd::min(batch(1.0), xsimd::max(batch(0.0), (t - t2) / (t3 - t2)));
+  batch f45 = xsimd::min(batch(1.0), xsimd::max(batch(0.0), (t - t3) / (batch(1.0) - t3)));
+
+  batch r = mix(c0_r, c1_r, f01);
+  batch g = mix(c0_g, c1_g, f01);
+  batch b = mix(c0_b, c1_b, f01);
+
+  r = select(t >= t0, mix(c1_r, c2_r, f12), r);
+  g = select(t >= t0, mix(c1_g, c2_g, f12), g);
+  b = select(t >= t0, mix(c1_b, c2_b, f12), b);
+
+  r = select(t >= t1, mix(c2_r, c3_r, f23), r);
+  g = select(t >= t1, mix(c2_g, c3_g, f23), g);
+  b = select(t >= t1, mix(c2_b, c3_b, f23), b);
+
+  r = select(t >= t2, mix(c3_r, c4_r, f34), r);
+  g = select(t >= t2, mix(c3_g, c4_g, f34), g);
+  b = select(t >= t2, mix(c3_b, c4_b, f34), b);
+
+  r = select(t >= t3, mix(c4_r, c5_r, f45), r);
+  g = select(t >= t3, mix(c4_g, c5_g, f45), g);
+  b = select(t >= t3, mix(c4_b, c5_b, f45), b);
+
+  return {r, g, b};
+}
+
+rgb hot_iron(const batch &t) {
+  static constexpr double t0 = 0.25, t1 = 0.5, t2 = 0.75;
+  static constexpr double inv_t0 = 4.0; // 1.0 / 0.25
+  static constexpr double inv_t1_t0 = 4.0; // 1.0 / (0.5 - 0.25)
+  static constexpr double inv_t2_t1 = 4.0; // 1.0 / (0.75 - 0.5)
+  static constexpr double inv_1_t2 = 4.0; // 1.0 / (1.0 - 0.75)
+
+  static constexpr double c0_r = 0.0, c0_g = 0.0, c0_b = 0.0;
+  static constexpr double c1_r = 0.5, c1_g = 0.0, c1_b = 0.0;
+  static constexpr double c2_r = 1.0, c2_g = 0.0, c2_b = 0.0;
+  static constexpr double c3_r = 1.0, c3_g = 165.0 / 255.0, c3_b = 0.0;
+  static constexpr double c4_r = 1.0, c4_g = 1.0, c4_b = 1.0;
+
+  batch f01 = clamp_unit(t * batch(inv_t0));
+  batch f12 = clamp_unit((t - batch(t0)) * batch(inv_t1_t0));
+  batch f23 = clamp_unit((t - batch(t1)) * batch(inv_t2_t1));
+  batch f34 = clamp_unit((t - batch(t2)) * batch(inv_1_t2));
+
+  batch r = mix(batch(c0_r), batch(c1_r), f01);
+  batch g = mix(batch(c0_g), batch(c1_g), f01);
+  batch b = mix(batch(c0_b), batch(c1_b), f01);
+
+  r = select(t >= batch(t0), mix(batch(c1_r), batch(c2_r), f12), r);
+  g = select(t >= batch(t0), mix(batch(c1_g), batch(c2_g), f12), g);
+  b = select(t >= batch(t0), mix(batch(c1_b), batch(c2_b), f12), b);
+
+  r = select(t >= batch(t1), mix(batch(c2_r), batch(c3_r), f23), r);
+  g = select(t >= batch(t1), mix(batch(c2_g), batch(c3_g), f23), g);
+  b = select(t >= batch(t1), mix(batch(c2_b), batch(c3_b), f23), b);
+
+  r = select(t >= batch(t2), mix(batch(c3_r), batch(c4_r), f34), r);
+  g = select(t >= batch(t2), mix(batch(c3_g), batch(c4_g), f34), g);
+  b = select(t >= batch(t2), mix(batch(c3_b), batch(c4_b), f34), b);
+
+  return {r, g, b};
+}
+
+rgb electric_blue(const batch &t) {
+  const batch c0_r = batch(0.0), c0_g = batch(0.0), c0_b = batch(50.0 / 255.0);
+  const batch c1_r = batch(0.0), c1_g = batch(100.0 / 255.0), c1_b = batch(1.0);
+  const batch c2_r = batch(0.0), c2_g = batch(1.0), c2_b = batch(1.0);
+
+  auto mask1 = t < batch(0.5);
+  auto f1 = xsimd::min(batch(1.0), xsimd::max(batch(0.0), t / batch(0.5)));
+  auto f2 = xsimd::min(batch(1.0), xsimd::max(batch(0.0), (t - batch(0.5)) / batch(0.5)));
+
+  auto r = select(mask1, mix(c0_r, c1_r, f1), mix(c1_r, c2_r, f2));
+  auto g = select(mask1, mix(c0_g, c1_g, f1), mix(c1_g, c2_g, f2));
+  auto b = select(mask1, mix(c0_b, c1_b, f1), mix(c1_b, c2_b, f2));
+
+  return {r, g, b};
+}
+
+rgb sunset(const batch &t) {
+  const batch t0 = batch(0.33);
+  const batch t1 = batch(0.66);
+
+  const batch c0_r = batch(25.0 / 255.0), c0_g = batch(0.0), c0_b = batch(51.0 / 255.0);
+  const batch c1_r = batch(1.0), c1_g = batch(0.0), c1_b = batch(127.0 / 255.0);
+  const batch c2_r = batch(1.0), c2_g = batch(127.0 / 255.0), c2_b = batch(0.0);
+  const batch c3_r = batch(1.0), c3_g = batch(1.0), c3_b = batch(0.0);
+
+  batch f01 = xsimd::min(batch(1.0), xsimd::max(batch(0.0), t / t0));
+  batch f12 = xsimd::min(batch(1.0), xsimd::max(batch(0.0), (t - t0) / (t1 - t0)));
+  batch f23 = xsimd::min(batch(1.0), xsimd::max(batch(0.0), (t - t1) / (batch(1.0) - t1)));
+
+  batch r = mix(c0_r, c1_r, f01);
+  batch g = mix(c0_g, c1_g, f01);
+  batch b = mix(c0_b, c1_b, f01);
+
+  r = select(t >= t0, mix(c1_r, c2_r, f12), r);
+  g = select(t >= t0, mix(c1_g, c2_g, f12), g);
+  b = select(t >= t0, mix(c1_b, c2_b, f12), b);
+
+  r = select(t >= t1, mix(c2_r, c3_r, f23), r);
+  g = select(t >= t1, mix(c2_g, c3_g, f23), g);
+  b = select(t >= t1, mix(c2_b, c3_b, f23), b);
+
+  return {r, g, b};
+}
+
+[[nodiscard]] constexpr rgb grayscale(const batch &t) noexcept {
+  return {t, t, t};
+}
+
+rgb blue_white(const batch &t) {
+  static constexpr double c0_r = 0.0, c0_g = 50.0 / 255.0, c0_b = 150.0 / 255.0;
+  static constexpr double c1_r = 1.0, c1_g = 1.0, c1_b = 1.0;
+
+  return {
+    mix(batch(c0_r), batch(c1_r), t),
+    mix(batch(c0_g), batch(c1_g), t),
+    mix(batch(c0_b), batch(c1_b), t)
+  };
+}
+
+// 🌈 Rainbow Spiral - Smooth HSV rainbow with spiral effect
+rgb rainbow_spiral(const batch &t) {
+  // Create spiral effect with frequency modulation
+  auto spiral_t = xsimd::fmod(t * batch(3.0), batch(1.0));
+
+  // Convert to HSV where H cycles through rainbow
+  auto hue = spiral_t * batch(360.0); // Full rainbow cycle
+  auto sat = batch(0.85) + batch(0.15) * xsimd::sin(t * batch(8.0)); // Slight saturation variation
+  auto val = batch(0.9) + batch(0.1) * xsimd::cos(t * batch(12.0)); // Slight brightness variation
+
+  // Simple HSV to RGB conversion for hue cycling
+  auto h_norm = xsimd::fmod(hue / batch(60.0), batch(6.0));
+  auto chroma = val * sat;
+  auto x = chroma * (batch(1.0) - xsimd::abs(xsimd::fmod(h_norm, batch(2.0)) - batch(1.0)));
+  auto m = val - chroma;
+
+  // Determine RGB based on hue sector
+  auto mask0 = h_norm < batch(1.0);
+  auto mask1 = (h_norm >= batch(1.0)) & (h_norm < batch(2.0));
+  auto mask2 = (h_norm >= batch(2.0)) & (h_norm < batch(3.0));
+  auto mask3 = (h_norm >= batch(3.0)) & (h_norm < batch(4.0));
+  auto mask4 = (h_norm >= batch(4.0)) & (h_norm < batch(5.0));
+
+  auto const zero = batch(0.0);
+  auto r = select(mask4, x, chroma);
+  auto g = zero;
+  auto b = select(mask4, chroma, x);
+  r = select(mask3, zero, r);
+  g = select(mask3, x, g);
+  b = select(mask3, chroma, b);
+  r = select(mask2, zero, r);
+  g = select(mask2, chroma, g);
+  b = select(mask2, x, b);
+  r = select(mask1, x, r);
+  g = select(mask1, chroma, g);
+  b = select(mask1, zero, b);
+  r = select(mask0, chroma, r) + m;
+  g = select(mask0, x, g) + m;
+  b = select(mask0, zero, b) + m;
+
+  return {r, g, b};
+}
+
+// 🌊 Ocean Depths - Deep blues to aqua to white foam
+rgb ocean_depths(const batch &t) {
+  static constexpr double t0 = 0.3, t1 = 0.6, t2 = 0.85;
+
+  // Deep ocean blue → Turquoise → Aqua → White foam
+  static constexpr double c0_r = 0.0, c0_g = 0.1, c0_b = 0.3;      // Deep blue
+  static constexpr double c1_r = 0.0, c1_g = 0.4, c1_b = 0.7;      // Medium blue
+  static constexpr double c2_r = 0.0, c2_g = 0.8, c2_b = 0.9;      // Turquoise
+  static constexpr double c3_r = 0.7, c3_g = 1.0, c3_b = 1.0;      // Light aqua
+  static constexpr double c4_r = 1.0, c4_g = 1.0, c4_b = 1.0;      // White foam
+
+  auto f01 = clamp_unit(t / batch(t0));
+  auto f12 = clamp_unit((t - batch(t0)) / batch(t1 - t0));
+  auto f23 = clamp_unit((t - batch(t1)) / batch(t2 - t1));
+  auto f34 = clamp_unit((t - batch(t2)) / batch(1.0 - t2));
+
+  auto r = mix(batch(c0_r), batch(c1_r), f01);
+  auto g = mix(batch(c0_g), batch(c1_g), f01);
+  auto b = mix(batch(c0_b), batch(c1_b), f01);
+
+  r = select(t >= batch(t0), mix(batch(c1_r), batch(c2_r), f12), r);
+  g = select(t >= batch(t0), mix(batch(c1_g), batch(c2_g), f12), g);
+  b = select(t >= batch(t0), mix(batch(c1_b), batch(c2_b), f12), b);
+
+  r = select(t >= batch(t1), mix(batch(c2_r), batch(c3_r), f23), r);
+  g = select(t >= batch(t1), mix(batch(c2_g), batch(c3_g), f23), g);
+  b = select(t >= batch(t1), mix(batch(c2_b), batch(c3_b), f23), b);
+
+  r = select(t >= batch(t2), mix(batch(c3_r), batch(c4_r), f34), r);
+  g = select(t >= batch(t2), mix(batch(c3_g), batch(c4_g), f34), g);
+  b = select(t >= batch(t2), mix(batch(c3_b), batch(c4_b), f34), b);
+
+  return {r, g, b};
+}
+
+// 🔥 Lava Flow - Black → deep red → orange → yellow → white
+rgb lava_flow(const batch &t) {
+  static constexpr double t0 = 0.2, t1 = 0.4, t2 = 0.7, t3 = 0.9;
+
+  // Volcanic progression
+  static constexpr double c0_r = 0.05, c0_g = 0.0, c0_b = 0.0;     // Nearly black
+  static constexpr double c1_r = 0.4, c1_g = 0.0, c1_b = 0.0;      // Deep red
+  static constexpr double c2_r = 0.8, c2_g = 0.2, c2_b = 0.0;      // Orange-red
+  static constexpr double c3_r = 1.0, c3_g = 0.6, c3_b = 0.0;      // Orange
+  static constexpr double c4_r = 1.0, c4_g = 1.0, c4_b = 0.4;      // Yellow
+  static constexpr double c5_r = 1.0, c5_g = 1.0, c5_b = 1.0;      // White hot
+
+  auto f01 = clamp_unit(t / batch(t0));
+  auto f12 = clamp_unit((t - batch(t0)) / batch(t1 - t0));
+  auto f23 = clamp_unit((t - batch(t1)) / batch(t2 - t1));
+  auto f34 = clamp_unit((t - batch(t2)) / batch(t3 - t2));
+  auto f45 = clamp_unit((t - batch(t3)) / batch(1.0 - t3));
+
+  auto r = mix(batch(c0_r), batch(c1_r), f01);
+  auto g = mix(batch(c0_g), batch(c1_g), f01);
+  auto b = mix(batch(c0_b), batch(c1_b), f01);
+
+  r = select(t >= batch(t0), mix(batch(c1_r), batch(c2_r), f12), r);
+  g = select(t >= batch(t0), mix(batch(c1_g), batch(c2_g), f12), g);
+  b = select(t >= batch(t0), mix(batch(c1_b), batch(c2_b), f12), b);
+
+  r = select(t >= batch(t1), mix(batch(c2_r), batch(c3_r), f23), r);
+  g = select(t >= batch(t1), mix(batch(c2_g), batch(c3_g), f23), g);
+  b = select(t >= batch(t1), mix(batch(c2_b), batch(c3_b), f23), b);
+
+  r = select(t >= batch(t2), mix(batch(c3_r), batch(c4_r), f34), r);
+  g = select(t >= batch(t2), mix(batch(c3_g), batch(c4_g), f34), g);
+  b = select(t >= batch(t2), mix(batch(c3_b), batch(c4_b), f34), b);
+
+  r = select(t >= batch(t3), mix(batch(c4_r), batch(c5_r), f45), r);
+  g = select(t >= batch(t3), mix(batch(c4_g), batch(c5_g), f45), g);
+  b = select(t >= batch(t3), mix(batch(c4_b), batch(c5_b), f45), b);
+
+  return {r, g, b};
+}
+
+// 🌸 Cherry Blossom - Soft pinks and whites with touches of green
+rgb cherry_blossom(const batch &t) {
+  static constexpr double t0 = 0.25, t1 = 0.5, t2 = 0.75;
+
+  // Delicate spring colors
+  static constexpr double c0_r = 0.2, c0_g = 0.4, c0_b = 0.2;      // Soft green
+  static constexpr double c1_r = 0.9, c1_g = 0.7, c1_b = 0.8;      // Light pink
+  static constexpr double c2_r = 1.0, c2_g = 0.8, c2_b = 0.9;      // Pale pink
+  static constexpr double c3_r = 0.95, c3_g = 0.5, c3_b = 0.7;     // Cherry blossom pink
+  static constexpr double c4_r = 1.0, c4_g = 1.0, c4_b = 1.0;      // Pure white
+
+  auto f01 = clamp_unit(t / batch(t0));
+  auto f12 = clamp_unit((t - batch(t0)) / batch(t1 - t0));
+  auto f23 = clamp_unit((t - batch(t1)) / batch(t2 - t1));
+  auto f34 = clamp_unit((t - batch(t2)) / batch(1.0 - t2));
+
+  auto r = mix(batch(c0_r), batch(c1_r), f01);
+  auto g = mix(batch(c0_g), batch(c1_g), f01);
+  auto b = mix(batch(c0_b), batch(c1_b), f01);
+
+  r = select(t >= batch(t0), mix(batch(c1_r), batch(c2_r), f12), r);
+  g = select(t >= batch(t0), mix(batch(c1_g), batch(c2_g), f12), g);
+  b = select(t >= batch(t0), mix(batch(c1_b), batch(c2_b), f12), b);
+
+  r = select(t >= batch(t1), mix(batch(c2_r), batch(c3_r), f23), r);
+  g = select(t >= batch(t1), mix(batch(c2_g), batch(c3_g), f23), g);
+  b = select(t >= batch(t1), mix(batch(c2_b), batch(c3_b), f23), b);
+
+  r = select(t >= batch(t2), mix(batch(c3_r), batch(c4_r), f34), r);
+  g = select(t >= batch(t2), mix(batch(c3_g), batch(c4_g), f34), g);
+  b = select(t >= batch(t2), mix(batch(c3_b), batch(c4_b), f34), b);
+
+  return {r, g, b};
+}
+
+// ⚡ Neon Cyberpunk - Electric purple/blue/cyan for futuristic vibes
+rgb neon_cyberpunk(const batch &t) {
+  static constexpr double t0 = 0.3, t1 = 0.6;
+
+  // Cyberpunk neon colors
+  static constexpr double c0_r = 0.1, c0_g = 0.0, c0_b = 0.2;      // Dark purple
+  static constexpr double c1_r = 0.5, c1_g = 0.0, c1_b = 1.0;      // Electric purple
+  static constexpr double c2_r = 0.0, c2_g = 0.5, c2_b = 1.0;      // Electric blue
+  static constexpr double c3_r = 0.0, c3_g = 1.0, c3_b = 1.0;      // Cyan
+  static constexpr double c4_r = 1.0, c4_g = 1.0, c4_b = 1.0;      // White glow
+
+  auto f01 = clamp_unit(t / batch(t0));
+  auto f12 = clamp_unit((t - batch(t0)) / batch(t1 - t0));
+  auto f23 = clamp_unit((t - batch(t1)) / batch(1.0 - t1));
+
+  auto r = mix(batch(c0_r), batch(c1_r), f01);
+  auto g = mix(batch(c0_g), batch(c1_g), f01);
+  auto b = mix(batch(c0_b), batch(c1_b), f01);
+
+  r = select(t >= batch(t0), mix(batch(c1_r), batch(c2_r), f12), r);
+  g = select(t >= batch(t0), mix(batch(c1_g), batch(c2_g), f12), g);
+  b = select(t >= batch(t0), mix(batch(c1_b), batch(c2_b), f12), b);
+
+  r = select(t >= batch(t1), mix(batch(c2_r), batch(c4_r), f23), r);
+  g = select(t >= batch(t1), mix(batch(c2_g), batch(c4_g), f23), g);
+  b = select(t >= batch(t1), mix(batch(c2_b), batch(c4_b), f23), b);
+
+  return {r, g, b};
+}
+
+// 🍂 Autumn Forest - Rich browns, oranges, golds, and deep reds
+rgb autumn_forest(const batch &t) {
+  static constexpr double t0 = 0.2, t1 = 0.4, t2 = 0.7;
+
+  // Autumn foliage colors
+  static constexpr double c0_r = 0.2, c0_g = 0.1, c0_b = 0.05;     // Dark brown
+  static constexpr double c1_r = 0.6, c1_g = 0.3, c1_b = 0.1;      // Rich brown
+  static constexpr double c2_r = 0.8, c2_g = 0.4, c2_b = 0.1;      // Orange-brown
+  static constexpr double c3_r = 1.0, c3_g = 0.6, c3_b = 0.0;      // Golden orange
+  static constexpr double c4_r = 0.8, c4_g = 0.2, c4_b = 0.1;      // Deep red
+  static constexpr double c5_r = 1.0, c5_g = 0.8, c5_b = 0.4;      // Golden yellow
+
+  auto f01 = clamp_unit(t / batch(t0));
+  auto f12 = clamp_unit((t - batch(t0)) / batch(t1 - t0));
+  auto f23 = clamp_unit((t - batch(t1)) / batch(t2 - t1));
+  auto f34 = clamp_unit((t - batch(t2)) / batch(1.0 - t2));
+
+  auto r = mix(batch(c0_r), batch(c1_r), f01);
+  auto g = mix(batch(c0_g), batch(c1_g), f01);
+  auto b = mix(batch(c0_b), batch(c1_b), f01);
+
+  r = select(t >= batch(t0), mix(batch(c1_r), batch(c2_r), f12), r);
+  g = select(t >= batch(t0), mix(batch(c1_g), batch(c2_g), f12), g);
+  b = select(t >= batch(t0), mix(batch(c1_b), batch(c2_b), f12), b);
+
+  r = select(t >= batch(t1), mix(batch(c2_r), batch(c3_r), f23), r);
+  g = select(t >= batch(t1), mix(batch(c2_g), batch(c3_g), f23), g);
+  b = select(t >= batch(t1), mix(batch(c2_b), batch(c3_b), f23), b);
+
+  r = select(t >= batch(t2), mix(batch(c3_r), batch(c5_r), f34), r);
+  g = select(t >= batch(t2), mix(batch(c3_g), batch(c5_g), f34), g);
+  b = select(t >= batch(t2), mix(batch(c3_b), batch(c5_b), f34), b);
+
+  return {r, g, b};
+}
+
+} // namespace
+
+/// Fractional iteration count of a sample from its escape iteration and final |z|^2; samples
+/// that did not escape keep their whole count.
+[[nodiscard]] inline auto smooth_count(batch const &iter, batch const &mag) -> batch {
+  auto const smooth_iter = iter - xsimd::log2(xsimd::log2(mag)) + std::log2(std::log2(4.0));
+  return select(mag > batch(4.0), smooth_iter, iter);
+}
+
+/// Colour coordinate of an iteration count on a log scale, 0 for an immediate escape and 1 at
+/// MAX_ITER.
+template <std::size_t MAX_ITER>
+[[nodiscard]] auto normalized(batch const &count) -> batch {
+  static auto const inv_log_max = 1.0 / std::log(static_cast<double>(MAX_ITER + 1));
+  return xsimd::log(count + 1.0) * inv_log_max;
+}
+
+/// Colour coordinate of a sample, optionally smoothed.
+template <std::size_t MAX_ITER>
+[[nodiscard]] auto normalized(batch const &iter, batch const &mag, bool smooth) -> batch {
+  return normalized<MAX_ITER>(smooth ? smooth_count(iter, mag) : iter);
+}
+
+/// Reference colour of `s` at normalized t, gamma-corrected to sRGB. Evaluates the scheme's
+/// formula directly; rendering goes through a palette built from it.
+template <std::size_t MAX_ITER>
+[[nodiscard]] auto shade_exact(scheme s, batch const &t) -> rgb {
+  batch r, g, b;
+  switch (s) {
+  case scheme::classic: std::tie(r, g, b) = classic(t); break;
+  case scheme::hot_iron: std::tie(r, g, b) = hot_iron(t); break;
+  case scheme::electric_blue: std::tie(r, g, b) = electric_blue(t); break;
+  case scheme::sunset: std::tie(r, g, b) = sunset(t); break;
+  case scheme::grayscale: std::tie(r, g, b) = grayscale(t); break;
+  case scheme::blue_white: std::tie(r, g, b) = blue_white(t); break;
+  case scheme::exponential_lch:
+    // Defined on the iteration count itself: undo the log scale
+    std::tie(r, g, b) = exponential_lch<MAX_ITER>(select(
+        t >= batch(1.0),
+        batch(static_cast<double>(MAX_ITER)),
+        xsimd::exp(t * std::log(static_cast<double>(MAX_ITER + 1))) - 1.0
+    ));
+    break;
+  case scheme::rainbow_spiral: std::tie(r, g, b) = rainbow_spiral(t); break;
+  case scheme::ocean_depths: std::tie(r, g, b) = ocean_depths(t); break;
+  case scheme::lava_flow: std::tie(r, g, b) = lava_flow(t); break;
+  case scheme::cherry_blossom: std::tie(r, g, b) = cherry_blossom(t); break;
+  case scheme::neon_cyberpunk: std::tie(r, g, b) = neon_cyberpunk(t); break;
+  case scheme::autumn_forest: std::tie(r, g, b) = autumn_forest(t); break;
+  case scheme::count:
+    // Error fallback - white to make it obvious
+    r = g = b = batch(1.0);
+    break;
+  }
+  // sRGB, so that supersamples can be averaged directly
+  return {gamma_correct(r), gamma_correct(g), gamma_correct(b)};
+}
+
+/// A colour scheme tabulated over t in [0, 1), already gamma-corrected, plus the colour at t = 1
+/// (points inside the set), which some schemes make discontinuous. Sampling is two gathers and a
+/// lerp per channel, whatever the cost of the scheme's formula.
+class palette {
+public:
+  static constexpr std::size_t SIZE = 8192;
+
+  palette() = default;
+
+  template <std::size_t MAX_ITER>
+  [[nodiscard]] static auto build(scheme s) -> palette {
+    constexpr auto lanes = batch::size;
+    auto p = palette{};
+    // One spare entry so the upper gather at t = 1 stays in bounds
+    p.r_.resize(SIZE + lanes);
+    p.g_.resize(SIZE + lanes);
+    p.b_.resize(SIZE + lanes);
+    alignas(alignof(batch)) double t_buf[lanes];
+    auto const below_one = std::nextafter(1.0, 0.0);
+    for (std::size_t i = 0; i < SIZE + 1; i += lanes) {
+      for (std::size_t lane = 0; lane != lanes; ++lane) {
+        t_buf[lane] = std::min(below_one, static_cast<double>(i + lane) / (SIZE - 1));
+      }
+      auto const [r, g, b] = shade_exact<MAX_ITER>(s, batch::load_aligned(t_buf));
+      r.store_unaligned(p.r_.data() + i);
+      g.store_unaligned(p.g_.data() + i);
+      b.store_unaligned(p.b_.data() + i);
+    }
+    auto const [r, g, b] = shade_exact<MAX_ITER>(s, batch(1.0));
+    p.inside_ = {r.get(0), g.get(0), b.get(0)};
+    return p;
+  }
+
+  [[nodiscard]] auto sample(batch t) const -> rgb {
+    using bsize = xsimd::batch<std::size_t>;
+    // NaN (e.g. a degenerate smooth count) compares false and lands on entry 0
+    t = xsimd::min(select(t >= batch(0.0), t, batch(0.0)), batch(1.0)) * (SIZE - 1);
+    auto const base = xsimd::floor(t);
+    auto const f = t - base;
+    auto const i0 = xsimd::batch_cast<std::size_t>(base);
+    auto const i1 = i0 + bsize(1);
+    auto const inside = t >= batch(SIZE - 1);
+    auto const channel = [&](std::vector<double> const &c, double inside_value) {
+      auto const v = mix(batch::gather(c.data(), i0), batch::gather(c.data(), i1), f);
+      return select(inside, batch(inside_value), v);
+    };
+    return {channel(r_, inside_[0]), channel(g_, inside_[1]), channel(b_, inside_[2])};
+  }
+
+private:
+  std::vector<double> r_;
+  std::vector<double> g_;
+  std::vector<double> b_;
+  std::array<double, 3> inside_{};
+};
+
+inline constexpr auto SCHEME_COUNT = static_cast<std::size_t>(scheme::count);
+
+/// Palettes for every scheme, indexed by scheme.
+template <std::size_t MAX_ITER>
+[[nodiscard]] auto build_palettes() -> std::array<palette, SCHEME_COUNT> {
+  std::array<palette, SCHEME_COUNT> palettes;
+  for (std::size_t s = 0; s != palettes.size(); ++s) {
+    palettes[s] = palette::build<MAX_ITER>(static_cast<scheme>(s));
+  }
+  return palettes;
+}
+
+} // namespace mandelbrot::colour
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include <xsimd/xsimd.hpp>
+
+#include "mandelbrot/backend.hpp"
+#include "mandelbrot/tile.hpp"
+
+namespace mandelbrot::tile {
+
+/// Samples per work item when deepening.
+inline constexpr std::size_t DEEPEN_CHUNK = 256;
+/// Longest cycle known_inside() looks for in an orbit.
+inline constexpr std::size_t INTERIOR_PERIOD_MAX = 1024;
+/// Squared distance within which an orbit counts as back where it started.
+inline constexpr double INTERIOR_CYCLE_TOLERANCE = 1e-20;
+
+/// Samples of an iteration map that had not escaped after `iter` iterations, each with the orbit
+/// point z = x + yi it had reached, so raising the limit only costs the iterations beyond it. The
+/// first `fresh` had no orbit kept and start over from z = 0. deepen() leaves every sample's new
+/// count and |z|^2 in `count` and `mag` without touching the map; settle() moves them in.
+struct interior {
+  std::size_t iter{};
+  std::size_t fresh{};
+  std::vector<std::size_t> points; // Indices into the map
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<std::size_t> count;
+  std::vector<double> mag;
+
+  [[nodiscard]] auto size() const -> std::size_t { return points.size(); }
+  [[nodiscard]] auto empty() const -> bool { return points.empty(); }
+};
+
+/// Samples of `map` still inside at `limit`. Those whose orbit the map kept go on from it; the
+/// rest come first and start over from z = 0.
+[[nodiscard]] inline auto find_interior(iteration_map const &map, std::size_t limit) -> interior {
+  auto in = interior{};
+  in.iter = limit;
+  auto resumed = std::vector<std::size_t>{};
+  for (std::size_t i = 0; i != map.iter.size(); ++i) {
+    if (map.iter[i] >= limit and map.mag[i] <= 4.0) {
+      (map.has_orbit(i) ? resumed : in.points).push_back(i);
+    }
+  }
+  in.fresh = in.size();
+  in.x.assign(in.fresh, 0.0);
+  in.y.assign(in.fresh, 0.0);
+  for (auto const i : resumed) {
+    in.points.push_back(i);
+    in.x.push_back(map.orbit_x[i]);
+    in.y.push_back(map.orbit_y[i]);
+  }
+  in.count.assign(in.size(), 0);
+  in.mag.assign(in.size(), 0.0);
+  return in;
+}
+
+/// Runs samples [first, last) of `in` on from in.iter, or from z = 0 for the fresh ones, to
+/// MAX_ITER iterations; `vp` is the viewport whose pixels are the map's samples. Returns how many
+/// of them escaped.
+template <std::size_t MAX_ITER>
+auto deepen(
+    viewport const &vp,
+    iteration_map const &map,
+    interior &in,
+    std::size_t first,
+    std::size_t last,
+    auto scheduler
+) -> std::size_t {
+  using batch = xsimd::batch<double>;
+  using bsize = xsimd::batch<std::size_t>;
+  constexpr auto lanes = batch::size;
+
+  auto escaped = std::atomic<std::size_t>{0};
+  parallel_for(scheduler, (last - first + DEEPEN_CHUNK - 1) / DEEPEN_CHUNK, [&](std::size_t c) {
+    alignas(alignof(batch)) double re[lanes];
+    alignas(alignof(batch)) double im[lanes];
+    alignas(alignof(batch)) double xs[lanes];
+    alignas(alignof(batch)) double ys[lanes];
+    alignas(alignof(bsize)) std::size_t iters[lanes];
+    alignas(alignof(batch)) double mags[lanes];
+    auto const begin = first + c * DEEPEN_CHUNK;
+    auto const end = std::min(begin + DEEPEN_CHUNK, last);
+    std::size_t out = 0;
+    // Batches never straddle the fresh samples and the resumed ones, which start apart
+    auto const run = [&](std::size_t from, std::size_t to, std::size_t start) {
+      for (auto i = from; i < to; i += lanes) {
+        // Pad the tail batch by repeating the last sample
+        auto const valid = std::min(lanes, to - i);
+        for (std::size_t lane = 0; lane != lanes; ++lane) {
+          auto const k = i + std::min(lane, valid - 1);
+          re[lane] = vp.real(static_cast<double>(in.points[k] % map.width) + 0.5);
+          im[lane] = vp.imag(static_cast<double>(in.points[k] / map.width) + 0.5);
+          xs[lane] = in.x[k];
+          ys[lane] = in.y[k];
+        }
+        auto x = batch::load_aligned(xs);
+        auto y = batch::load_aligned(ys);
+        auto const [iter, mag] = escape_from<MAX_ITER>(
+            batch::load_aligned(re), batch::load_aligned(im), start, x, y
+        );
+        iter.store_aligned(iters);
+        mag.store_aligned(mags);
+        x.store_aligned(xs);
+        y.store_aligned(ys);
+        for (std::size_t lane = 0; lane != valid; ++lane) {
+          in.x[i + lane] = xs[lane];
+          in.y[i + lane] = ys[lane];
+          in.count[i + lane] = iters[lane];
+          in.mag[i + lane] = mags[lane];
+          out += mags[lane] > 4.0;
+        }
+      }
+    };
+    auto const split = std::clamp(in.fresh, begin, end);
+    run(begin, split, 0);
+    run(split, end, in.iter);
+    escaped.fetch_add(out, std::memory_order_relaxed);
+  });
+  return escaped.load();
+}
+
+/// Whether c lies in the main cardioid or the period-2 bulb, which no limit ever lets escape.
+[[nodiscard]] inline auto in_main_bulbs(double re, double im) -> bool {
+  auto const x = re - 0.25;
+  auto const q = x * x + im * im;
+  return q * (q + x) <= 0.25 * im * im or (re + 1.0) * (re + 1.0) + im * im <= 0.0625;
+}
+
+/// Whether no sample of `in` can escape at any limit: each lies in the main cardioid or the
+/// period-2 bulb, or its orbit has settled onto a cycle of at most INTERIOR_PERIOD_MAX points. A
+/// false answer only means one of them could not be shown inside; it stops at the first.
+[[nodiscard]] inline auto known_inside(
+    viewport const &vp, iteration_map const &map, interior const &in
+) -> bool {
+  for (std::size_t i = 0; i != in.size(); ++i) {
+    auto const re = vp.real(static_cast<double>(in.points[i] % map.width) + 0.5);
+    auto const im = vp.imag(static_cast<double>(in.points[i] / map.width) + 0.5);
+    if (in_main_bulbs(re, im)) {
+      continue;
+    }
+    auto x = in.x[i];
+    auto y = in.y[i];
+    auto cycled = false;
+    for (std::size_t period = 0; period != INTERIOR_PERIOD_MAX and not cycled; ++period) {
+      auto const next_x = x * x - y * y + re;
+      y = 2.0 * x * y + im;
+      x = next_x;
+      auto const dx = x - in.x[i];
+      auto const dy = y - in.y[i];
+      cycled = dx * dx + dy * dy < INTERIOR_CYCLE_TOLERANCE;
+    }
+    if (not cycled) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Once every sample of `in` has been deepened to `limit`: writes their counts, and the orbits of
+/// those still inside, into `map` and keeps only the samples still inside. Returns the number
+/// that escaped.
+inline auto settle(iteration_map &map, interior &in, std::size_t limit) -> std::size_t {
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i != in.size(); ++i) {
+    auto const p = in.points[i];
+    map.iter[p] = in.count[i];
+    map.mag[p] = in.mag[i];
+    if (in.mag[i] <= 4.0) {
+      map.keep_orbit(p, in.x[i], in.y[i]);
+      in.points[kept] = p;
+      in.x[kept] = in.x[i];
+      in.y[kept] = in.y[i];
+      ++kept;
+    }
+  }
+  auto const escaped = in.size() - kept;
+  in.points.resize(kept);
+  in.x.resize(kept);
+  in.y.resize(kept);
+  in.count.resize(kept);
+  in.mag.resize(kept);
+  in.iter = limit;
+  in.fresh = 0;
+  return escaped;
+}
+
+} // namespace mandelbrot::tile
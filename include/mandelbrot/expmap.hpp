@@ -0,0 +1,245 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <utility>
+#include <vector>
+
+#include <xsimd/xsimd.hpp>
+
+#include "mandelbrot/backend.hpp"
+#include "mandelbrot/colour.hpp"
+#include "mandelbrot/image.hpp"
+#include "mandelbrot/tile.hpp"
+
+namespace mandelbrot {
+
+namespace tile {
+
+/// Log-polar sampling of the plane around a centre, for zooms into it. Column u is the angle
+/// 2 pi (u + 0.5) / width; row v the radius outer_radius * exp(-(v + 0.5) * log_step()). Steps
+/// are equal in angle and log radius, so samples stay square and every row is a circle one step
+/// deeper than the last: a zoom by f is a shift of ln(f) / log_step() rows.
+struct exp_map {
+  double center_x{};
+  double center_y{};
+  double outer_radius{};
+  std::size_t width{};
+  std::size_t height{};
+
+  [[nodiscard]] auto log_step() const -> double {
+    return 2.0 * std::numbers::pi / static_cast<double>(width);
+  }
+  [[nodiscard]] auto radius(double v) const -> double {
+    return outer_radius * std::exp(-(v + 0.5) * log_step());
+  }
+};
+
+/// The exp_map covering every frame of a zoom about the centre of `first` (any frame size and
+/// zoom) to `last_zoom`, with n x n samples per frame pixel at the frame corners, where the
+/// angular spacing is coarsest.
+[[nodiscard]] inline auto exp_map_for(
+    viewport const &first,
+    double last_zoom,
+    std::size_t samples_per_side
+) -> exp_map {
+  auto const n = static_cast<double>(samples_per_side);
+  auto const last = viewport{first.center_x, first.center_y, last_zoom, first.width, first.height};
+  auto const corner =
+      std::hypot(static_cast<double>(first.width), static_cast<double>(first.height));
+  auto const widest = std::max(first.scale(), last.scale());
+  auto const narrowest = std::min(first.scale(), last.scale());
+
+  auto em = exp_map{first.center_x, first.center_y};
+  em.width = static_cast<std::size_t>(std::ceil(std::numbers::pi * corner * n));
+  // One spare row outside the corners; inside, down to a quarter sample from the centre
+  em.outer_radius = widest * corner / 2.0 * std::exp(em.log_step());
+  auto const inner_radius = narrowest * 0.25 / n;
+  em.height = static_cast<std::size_t>(
+      std::ceil(std::log(em.outer_radius / inner_radius) / em.log_step())
+  );
+  return em;
+}
+
+/// Evaluates rows [row, row + map.height) of `em` into `map` (em.width wide), one tile per work
+/// item.
+template <std::size_t MAX_ITER>
+void render_exp_rows(exp_map const &em, iteration_map &map, std::size_t row, auto scheduler) {
+  using batch = xsimd::batch<double>;
+  using bsize = xsimd::batch<std::size_t>;
+  constexpr auto lanes = batch::size;
+
+  // Padded to whole batches so the tail can load past the last column
+  auto const padded = (em.width + lanes - 1) / lanes * lanes;
+  auto cosines = std::vector<double>(padded);
+  auto sines = std::vector<double>(padded);
+  for (std::size_t u = 0; u != em.width; ++u) {
+    auto const theta = (static_cast<double>(u) + 0.5) * em.log_step();
+    cosines[u] = std::cos(theta);
+    sines[u] = std::sin(theta);
+  }
+
+  auto const region = rect{0, 0, map.width, map.height};
+  auto const [tiles_x, tiles_y] = tile_count(region);
+  parallel_for(scheduler, tiles_x * tiles_y, [&](std::size_t i) {
+    alignas(alignof(bsize)) std::size_t iters[lanes];
+    alignas(alignof(batch)) double mags[lanes];
+    auto const r = tile_bounds(region, i % tiles_x, i / tiles_x);
+    for (auto y = r.y; y != r.y + r.height; ++y) {
+      auto const radius = batch(em.radius(static_cast<double>(row + y)));
+      for (auto x = r.x; x < r.x + r.width; x += lanes) {
+        auto const [iter, mag] = escape_simd<MAX_ITER>(
+            fma(radius, batch::load_unaligned(cosines.data() + x), batch(em.center_x)),
+            fma(radius, batch::load_unaligned(sines.data() + x), batch(em.center_y))
+        );
+        iter.store_aligned(iters);
+        mag.store_aligned(mags);
+        auto const valid = std::min(lanes, r.x + r.width - x);
+        for (std::size_t lane = 0; lane != valid; ++lane) {
+          map.iter[map.index(x + lane, y)] = iters[lane];
+          map.mag[map.index(x + lane, y)] = mags[lane];
+        }
+      }
+    }
+  });
+}
+
+} // namespace tile
+
+/// Rows of an exp_map rendered per band, bounding the iteration data held at once.
+inline constexpr std::size_t EXP_MAP_BAND = 4 * tile::TILE_SIZE;
+
+/// Renders and colours the whole of `em` into `strip` (em.width x em.height). Returns the
+/// iterations spent.
+template <std::size_t MAX_ITER>
+auto render_exp_strip(
+    tile::exp_map const &em,
+    colour::palette const &pal,
+    bool smooth,
+    auto scheduler,
+    std::size_t workers,
+    rgb_image &strip
+) -> double {
+  strip.resize(em.width, em.height);
+  auto band = tile::iteration_map{};
+  auto iterations = 0.0;
+  for (std::size_t row = 0; row < em.height; row += EXP_MAP_BAND) {
+    band.resize(em.width, std::min(EXP_MAP_BAND, em.height - row));
+    tile::render_exp_rows<MAX_ITER>(em, band, row, scheduler);
+    colour::shade<MAX_ITER>(
+        band,
+        1,
+        {0, 0, band.width, band.height},
+        pal,
+        smooth,
+        scheduler,
+        workers,
+        [&](std::size_t x, std::size_t y, std::uint8_t r, std::uint8_t g, std::uint8_t b) {
+          auto *p = strip.row(row + y).data() + x * 3;
+          p[0] = r;
+          p[1] = g;
+          p[2] = b;
+        }
+    );
+    for (auto const i : band.iter) {
+      iterations += static_cast<double>(i);
+    }
+  }
+  return iterations;
+}
+
+/// Synthesizes frames of a zoom from a coloured exp_map strip. The strip coordinates of every
+/// sample are worked out once for `reference`; a frame at another zoom only shifts their row by
+/// ln(zoom ratio) / log_step(), so each frame is a bilinear gather from the strip.
+class exp_reprojector {
+public:
+  exp_reprojector(tile::exp_map const &em, tile::viewport const &reference, std::size_t n)
+      : em_(em), reference_(reference), samples_per_side_(n),
+        coords_(reference.width * reference.height * n * n) {
+    auto const step = reference.scale() / static_cast<double>(n);
+    auto const half_w = static_cast<double>(reference.width * n) / 2.0;
+    auto const half_h = static_cast<double>(reference.height * n) / 2.0;
+    auto const two_pi = 2.0 * std::numbers::pi;
+    auto next = coords_.begin();
+    for (std::size_t py = 0; py != reference.height; ++py) {
+      for (std::size_t px = 0; px != reference.width; ++px) {
+        for (std::size_t sy = 0; sy != n; ++sy) {
+          for (std::size_t sx = 0; sx != n; ++sx) {
+            auto const dx = (static_cast<double>(px * n + sx) + 0.5 - half_w) * step;
+            auto const dy = (half_h - static_cast<double>(py * n + sy) - 0.5) * step;
+            auto theta = std::atan2(dy, dx);
+            theta = theta < 0.0 ? theta + two_pi : theta;
+            auto const u = theta / em.log_step() - 0.5;
+            auto const v = std::log(em.outer_radius / std::hypot(dx, dy)) / em.log_step() - 0.5;
+            *next++ = {static_cast<float>(u), static_cast<float>(v)};
+          }
+        }
+      }
+    }
+  }
+
+  /// The frame at `zoom` about the strip's centre, sized like the reference frame.
+  void frame(
+      rgb_image const &strip,
+      double zoom,
+      auto scheduler,
+      std::size_t workers,
+      rgb_image &out
+  ) const {
+    auto const n = samples_per_side_;
+    auto const shift = std::log(zoom / reference_.zoom) / em_.log_step();
+    auto const last_row = static_cast<double>(em_.height - 1);
+    auto const inv_samples = 1.0 / static_cast<double>(n * n);
+    out.resize(reference_.width, reference_.height);
+
+    parallel_for_chunked(scheduler, out.height, workers, [&](std::size_t begin, std::size_t end) {
+      for (auto py = begin; py != end; ++py) {
+        auto const *coord = coords_.data() + py * out.width * n * n;
+        auto *dst = out.row(py).data();
+        for (std::size_t px = 0; px != out.width; ++px) {
+          double acc[3] = {};
+          for (std::size_t s = 0; s != n * n; ++s, ++coord) {
+            auto const u = static_cast<double>(coord->first);
+            auto const v = std::clamp(static_cast<double>(coord->second) + shift, 0.0, last_row);
+            auto const u0 = std::floor(u);
+            auto const v0 = std::floor(v);
+            auto const fu = u - u0;
+            auto const fv = v - v0;
+            // Angles wrap around; the radius is clamped
+            auto const c0 = wrap(static_cast<std::ptrdiff_t>(u0));
+            auto const c1 = wrap(static_cast<std::ptrdiff_t>(u0) + 1);
+            auto const r0 = static_cast<std::size_t>(v0);
+            auto const r1 = std::min(r0 + 1, em_.height - 1);
+            auto const *a = strip.row(r0).data();
+            auto const *b = strip.row(r1).data();
+            for (std::size_t ch = 0; ch != 3; ++ch) {
+              auto const top = a[c0 * 3 + ch] + fu * (a[c1 * 3 + ch] - a[c0 * 3 + ch]);
+              auto const bottom = b[c0 * 3 + ch] + fu * (b[c1 * 3 + ch] - b[c0 * 3 + ch]);
+              acc[ch] += top + fv * (bottom - top);
+            }
+          }
+          for (std::size_t ch = 0; ch != 3; ++ch) {
+            auto const value = std::clamp(acc[ch] * inv_samples + 0.5, 0.0, 255.0);
+            dst[px * 3 + ch] = static_cast<std::uint8_t>(value);
+          }
+        }
+      }
+    });
+  }
+
+private:
+  [[nodiscard]] auto wrap(std::ptrdiff_t u) const -> std::size_t {
+    auto const w = static_cast<std::ptrdiff_t>(em_.width);
+    return static_cast<std::size_t>(((u % w) + w) % w);
+  }
+
+  tile::exp_map em_;
+  tile::viewport reference_;
+  std::size_t samples_per_side_;
+  std::vector<std::pair<float, float>> coords_;
+};
+
+} // namespace mandelbrot
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+namespace mandelbrot::tile {
+
+/// Pixel block sizes an interactive preview can be rendered at, finest first.
+inline constexpr std::array<std::size_t, 5> PREVIEW_FACTORS = {1, 2, 4, 8, 16};
+
+/// Chooses how coarse interactive previews are so that one fits a frame time target. It learns
+/// the iteration throughput, and how many iterations a sample of the current scene takes, from
+/// the previews it has timed; both are smoothed so that one slow frame does not swing the choice.
+class quality_governor {
+public:
+  explicit quality_governor(std::chrono::duration<double> target) : target_(target.count()) {}
+
+  /// Records a render of `samples` samples that took `iterations` iterations in all.
+  void record(std::size_t samples, std::size_t iterations, std::chrono::duration<double> elapsed) {
+    if (samples == 0 or iterations == 0 or elapsed.count() <= 0.0) {
+      return;
+    }
+    auto const blend = [](double &average, double value) {
+      average += SMOOTHING * (value - average);
+    };
+    blend(rate_, static_cast<double>(iterations) / elapsed.count());
+    blend(iterations_per_sample_, static_cast<double>(iterations) / static_cast<double>(samples));
+  }
+
+  /// Predicted seconds to render `pixels` pixels one sample per `factor` x `factor` block.
+  [[nodiscard]] auto predict(std::size_t pixels, std::size_t factor) const -> double {
+    auto const samples = static_cast<double>(pixels) / static_cast<double>(factor * factor);
+    return samples * iterations_per_sample_ / rate_;
+  }
+
+  /// The finest block size a preview of `pixels` pixels fits the target at, else the coarsest.
+  [[nodiscard]] auto factor(std::size_t pixels) const -> std::size_t {
+    for (auto const f : PREVIEW_FACTORS) {
+      if (predict(pixels, f) <= target_) {
+        return f;
+      }
+    }
+    return PREVIEW_FACTORS.back();
+  }
+
+  /// Measured throughput in billions of iterations per second.
+  [[nodiscard]] auto giters_per_second() const -> double { return rate_ * 1e-9; }
+
+private:
+  static constexpr double SMOOTHING = 0.25;
+
+  double target_;
+  double rate_ = 1e9; // Iterations per second, until something has been measured
+  double iterations_per_sample_ = 100.0;
+};
+
+} // namespace mandelbrot::tile
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <xsimd/xsimd.hpp>
+
+#include "mandelbrot/backend.hpp"
+#include "mandelbrot/colour.hpp"
+#include "mandelbrot/tile.hpp"
+
+namespace mandelbrot {
+
+/// 8-bit sRGB raster, row-major, three bytes per pixel.
+struct rgb_image {
+  std::size_t width{};
+  std::size_t height{};
+  std::vector<std::uint8_t> pixels;
+
+  void resize(std::size_t w, std::size_t h) {
+    width = w;
+    height = h;
+    pixels.resize(w * h * 3);
+  }
+  [[nodiscard]] auto row(std::size_t y) -> std::span<std::uint8_t> {
+    return {pixels.data() + y * width * 3, width * 3};
+  }
+  [[nodiscard]] auto row(std::size_t y) const -> std::span<std::uint8_t const> {
+    return {pixels.data() + y * width * 3, width * 3};
+  }
+};
+
+/// Writes an encoded file in one go.
+inline void write_bytes(std::filesystem::path const &path, std::span<std::uint8_t const> bytes) {
+  auto out = std::ofstream(path, std::ios::binary);
+  out.write(reinterpret_cast<char const *>(bytes.data()), std::ssize(bytes));
+  if (not out) {
+    throw std::runtime_error("cannot write " + path.string());
+  }
+}
+
+/// Binary PPM (P6) header; the pixels follow as they are in an rgb_image.
+[[nodiscard]] inline auto ppm_header(std::size_t width, std::size_t height) -> std::string {
+  return "P6\n" + std::to_string(width) + ' ' + std::to_string(height) + "\n255\n";
+}
+
+/// Binary PPM (P6).
+inline void write_ppm(std::filesystem::path const &path, rgb_image const &image) {
+  auto out = std::ofstream(path, std::ios::binary);
+  out << ppm_header(image.width, image.height);
+  out.write(reinterpret_cast<char const *>(image.pixels.data()), std::ssize(image.pixels));
+  if (not out) {
+    throw std::runtime_error("cannot write " + path.string());
+  }
+}
+
+/// Binary PPM (P6) written a band of rows at a time, for images too large to hold in memory.
+class ppm_writer {
+public:
+  ppm_writer(std::filesystem::path const &path, std::size_t width, std::size_t height)
+      : path_(path), out_(path, std::ios::binary), width_(width), height_(height) {
+    out_ << ppm_header(width, height);
+    check();
+  }
+
+  /// Appends the rows of `band`, which must be as wide as the image.
+  void write(rgb_image const &band) {
+    if (band.width != width_ or rows_ + band.height > height_) {
+      throw std::runtime_error("band does not fit " + path_.string());
+    }
+    out_.write(reinterpret_cast<char const *>(band.pixels.data()), std::ssize(band.pixels));
+    rows_ += band.height;
+    check();
+  }
+
+  /// Flushes the file; throws unless every row has been written.
+  void finish() {
+    if (rows_ != height_) {
+      throw std::runtime_error("incomplete image " + path_.string());
+    }
+    out_.flush();
+    check();
+  }
+
+private:
+  void check() {
+    if (not out_) {
+      throw std::runtime_error("cannot write " + path_.string());
+    }
+  }
+
+  std::filesystem::path path_;
+  std::ofstream out_;
+  std::size_t width_;
+  std::size_t height_;
+  std::size_t rows_{};
+};
+
+/// Halves `src` (even width and height) with a 2 x 2 box filter into `dst` at pixel (x, y).
+inline void downsample_into(rgb_image const &src, rgb_image &dst, std::size_t x, std::size_t y) {
+  using wide = xsimd::batch<std::uint16_t>;
+  constexpr auto lanes = wide::size;
+  auto const bytes = src.width * 3;
+  // Room for the tail batch and its look-ahead of one pixel
+  auto sums = std::vector<std::uint16_t>(bytes + lanes + 3);
+
+  for (std::size_t oy = 0; oy != src.height / 2; ++oy) {
+    auto const *a = src.row(2 * oy).data();
+    auto const *b = src.row(2 * oy + 1).data();
+    // Vertical pairs, widened so four samples cannot overflow
+    auto i = std::size_t{};
+    for (; i + lanes <= bytes; i += lanes) {
+      auto const pair = wide::load_unaligned(a + i) + wide::load_unaligned(b + i);
+      pair.store_unaligned(sums.data() + i);
+    }
+    for (; i != bytes; ++i) {
+      sums[i] = static_cast<std::uint16_t>(a[i] + b[i]);
+    }
+    // Plus the same channel of the next pixel, rounded; valid at the first pixel of each pair
+    for (std::size_t i = 0; i < bytes; i += lanes) {
+      auto const total = wide::load_unaligned(sums.data() + i) +
+                         wide::load_unaligned(sums.data() + i + 3) + wide(2);
+      (total >> 2).store_unaligned(sums.data() + i);
+    }
+    auto *out = dst.row(y + oy).data() + x * 3;
+    for (std::size_t ox = 0; ox != src.width / 2; ++ox) {
+      out[ox * 3 + 0] = static_cast<std::uint8_t>(sums[ox * 6 + 0]);
+      out[ox * 3 + 1] = static_cast<std::uint8_t>(sums[ox * 6 + 1]);
+      out[ox * 3 + 2] = static_cast<std::uint8_t>(sums[ox * 6 + 2]);
+    }
+  }
+}
+
+namespace colour {
+
+/// Colour pass over `region` (pixels) of a map holding n x n samples per pixel: each sample goes
+/// through `pal` and the pixel gets the mean of its samples' sRGB values, handed to
+/// `sink(px, py, r, g, b)`. Rows are spread over the scheduler.
+template <std::size_t MAX_ITER>
+void shade(
+    tile::iteration_map const &map,
+    std::size_t samples_per_side,
+    tile::rect region,
+    palette const &pal,
+    bool smooth,
+    auto scheduler,
+    std::size_t workers,
+    auto &&sink
+) {
+  constexpr auto lanes = batch::size;
+  auto const n = samples_per_side;
+  auto const sample_begin = region.x * n;
+  auto const sample_end = (region.x + region.width) * n;
+  auto const inv_samples = 1.0 / static_cast<double>(n * n);
+
+  auto shade_rows = [&](std::size_t row_start, std::size_t row_end) {
+    alignas(alignof(batch)) double iter_buf[lanes];
+    alignas(alignof(batch)) double mag_buf[lanes];
+    alignas(alignof(batch)) double r_buf[lanes];
+    alignas(alignof(batch)) double g_buf[lanes];
+    alignas(alignof(batch)) double b_buf[lanes];
+    auto acc = std::vector<double>(region.width * 3);
+
+    for (auto py = region.y + row_start; py != region.y + row_end; ++py) {
+      std::fill(acc.begin(), acc.end(), 0.0);
+      for (std::size_t sy = 0; sy != n; ++sy) {
+        auto const row = (py * n + sy) * map.width;
+        for (auto sx = sample_begin; sx < sample_end; sx += lanes) {
+          // Pad the tail batch by repeating the last sample
+          auto const valid = std::min(lanes, sample_end - sx);
+          for (std::size_t lane = 0; lane != lanes; ++lane) {
+            auto const idx = row + sx + std::min(lane, valid - 1);
+            iter_buf[lane] = static_cast<double>(map.iter[idx]);
+            mag_buf[lane] = map.mag[idx];
+          }
+          auto const t = normalized<MAX_ITER>(
+              batch::load_aligned(iter_buf), batch::load_aligned(mag_buf), smooth
+          );
+          auto const [r, g, b] = pal.sample(t);
+          r.store_aligned(r_buf);
+          g.store_aligned(g_buf);
+          b.store_aligned(b_buf);
+          for (std::size_t lane = 0; lane != valid; ++lane) {
+            auto const px = (sx + lane - sample_begin) / n;
+            acc[px * 3 + 0] += r_buf[lane];
+            acc[px * 3 + 1] += g_buf[lane];
+            acc[px * 3 + 2] += b_buf[lane];
+          }
+        }
+      }
+      auto const to_byte = [&](double v) {
+        return static_cast<std::uint8_t>(std::clamp(255.0 * v * inv_samples, 0.0, 255.0));
+      };
+      for (std::size_t px = 0; px != region.width; ++px) {
+        sink(
+            region.x + px,
+            py,
+            to_byte(acc[px * 3 + 0]),
+            to_byte(acc[px * 3 + 1]),
+            to_byte(acc[px * 3 + 2])
+        );
+      }
+    }
+  };
+
+  parallel_for_chunked(scheduler, region.height, workers, shade_rows);
+}
+
+/// Colours the whole of `map` into `image`, sized to the map's pixels.
+template <std::size_t MAX_ITER>
+void shade(
+    tile::iteration_map const &map,
+    std::size_t samples_per_side,
+    palette const &pal,
+    bool smooth,
+    auto scheduler,
+    std::size_t workers,
+    rgb_image &image
+) {
+  image.resize(map.width / samples_per_side, map.height / samples_per_side);
+  shade<MAX_ITER>(
+      map,
+      samples_per_side,
+      {0, 0, image.width, image.height},
+      pal,
+      smooth,
+      scheduler,
+      workers,
+      [&](std::size_t x, std::size_t y, std::uint8_t r, std::uint8_t g, std::uint8_t b) {
+        auto *p = image.pixels.data() + (y * image.width + x) * 3;
+        p[0] = r;
+        p[1] = g;
+        p[2] = b;
+      }
+  );
+}
+
+} // namespace colour
+
+} // namespace mandelbrot
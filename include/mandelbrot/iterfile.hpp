@@ -0,0 +1,262 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <xsimd/xsimd.hpp>
+
+#include "mandelbrot/backend.hpp"
+#include "mandelbrot/colour.hpp"
+#include "mandelbrot/image.hpp"
+#include "mandelbrot/tile.hpp"
+
+namespace mandelbrot {
+
+inline constexpr std::uint64_t ITERATION_FILE_MAGIC = 0x31524554'49424D4DULL; // "MMBITER1"
+
+/// Header of an iteration file: where the render was and how it was sampled. The data follows as
+/// float smooth iteration counts, one tile of tile_size x tile_size pixels (n x n samples each) at
+/// a time, tiles in row-major order and padded to whole tiles, so any tile is one contiguous run
+/// that can be read straight from a mapping. Inside samples hold max_iter.
+struct iteration_file_header {
+  std::uint64_t magic = ITERATION_FILE_MAGIC;
+  double center_x{};
+  double center_y{};
+  double zoom{};
+  std::uint64_t max_iter{};
+  std::uint32_t width{}; // Pixels
+  std::uint32_t height{};
+  std::uint32_t samples_per_side{};
+  std::uint32_t tile_size{}; // Pixels
+  std::uint64_t reserved{};
+
+  [[nodiscard]] auto tile_samples() const -> std::size_t {
+    return std::size_t{tile_size} * samples_per_side;
+  }
+  [[nodiscard]] auto tiles_x() const -> std::size_t {
+    return (std::size_t{width} + tile_size - 1) / tile_size;
+  }
+  [[nodiscard]] auto tiles_y() const -> std::size_t {
+    return (std::size_t{height} + tile_size - 1) / tile_size;
+  }
+  [[nodiscard]] auto tile_row_bytes() const -> std::size_t {
+    return tiles_x() * tile_samples() * tile_samples() * sizeof(float);
+  }
+  [[nodiscard]] auto file_size() const -> std::size_t {
+    return sizeof(iteration_file_header) + tiles_y() * tile_row_bytes();
+  }
+};
+static_assert(sizeof(iteration_file_header) == 64);
+
+/// Smooth counts of sample rows [top, top + tile_samples()) of `map` (the full width) as a row
+/// of tiles laid out as in the file; samples beyond the image hold max_iter.
+inline void encode_tile_row(
+    iteration_file_header const &header,
+    tile::iteration_map const &map,
+    std::size_t top,
+    std::vector<float> &tiles
+) {
+  using batch = colour::batch;
+  constexpr auto lanes = batch::size;
+  auto const side = header.tile_samples();
+  alignas(alignof(batch)) double iter_buf[lanes];
+  alignas(alignof(batch)) double mag_buf[lanes];
+  alignas(alignof(batch)) double count_buf[lanes];
+
+  tiles.assign(header.tiles_x() * side * side, static_cast<float>(header.max_iter));
+  for (std::size_t y = 0; y != std::min(side, map.height - top); ++y) {
+    auto const *iter = map.iter.data() + (top + y) * map.width;
+    auto const *mag = map.mag.data() + (top + y) * map.width;
+    for (std::size_t x = 0; x < map.width; x += lanes) {
+      auto const valid = std::min(lanes, map.width - x);
+      for (std::size_t lane = 0; lane != lanes; ++lane) {
+        iter_buf[lane] = static_cast<double>(iter[x + std::min(lane, valid - 1)]);
+        mag_buf[lane] = mag[x + std::min(lane, valid - 1)];
+      }
+      colour::smooth_count(batch::load_aligned(iter_buf), batch::load_aligned(mag_buf))
+          .store_aligned(count_buf);
+      for (std::size_t lane = 0; lane != valid; ++lane) {
+        auto const sx = x + lane;
+        tiles[(sx / side * side + y) * side + sx % side] = static_cast<float>(count_buf[lane]);
+      }
+    }
+  }
+}
+
+/// Writes an iteration file a row of tiles at a time.
+class iteration_file_writer {
+public:
+  iteration_file_writer(std::filesystem::path const &path, iteration_file_header const &header)
+      : path_(path), out_(path, std::ios::binary), header_(header) {
+    out_.write(reinterpret_cast<char const *>(&header_), sizeof(header_));
+    check();
+  }
+
+  /// Appends the next rows of samples: `map` is the full width and a whole number of tile rows
+  /// high, except at the bottom of the image.
+  void write(tile::iteration_map const &map) {
+    for (std::size_t top = 0; top < map.height; top += header_.tile_samples()) {
+      encode_tile_row(header_, map, top, tiles_);
+      auto const bytes = static_cast<std::streamsize>(tiles_.size() * sizeof(float));
+      out_.write(reinterpret_cast<char const *>(tiles_.data()), bytes);
+      ++tile_rows_;
+    }
+    check();
+  }
+
+  void finish() {
+    if (tile_rows_ != header_.tiles_y()) {
+      throw std::runtime_error("incomplete iteration file " + path_.string());
+    }
+    out_.close();
+    check();
+  }
+
+private:
+  void check() const {
+    if (not out_) {
+      throw std::runtime_error("cannot write " + path_.string());
+    }
+  }
+
+  std::filesystem::path path_;
+  std::ofstream out_;
+  iteration_file_header header_;
+  std::vector<float> tiles_;
+  std::size_t tile_rows_ = 0;
+};
+
+/// Read-only mapping of an iteration file.
+class iteration_file {
+public:
+  explicit iteration_file(std::filesystem::path const &path) {
+    auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "cannot open " + path.string());
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+      auto const error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "cannot stat " + path.string());
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    data_ = size_ < sizeof(header_) ? MAP_FAILED
+                                    : ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    auto const error = errno;
+    ::close(fd);
+    if (data_ == MAP_FAILED) {
+      data_ = nullptr;
+      if (size_ < sizeof(header_)) {
+        throw std::runtime_error("not an iteration file: " + path.string());
+      }
+      throw std::system_error(error, std::generic_category(), "cannot map " + path.string());
+    }
+    // Tiles are read in order, each once
+    ::madvise(data_, size_, MADV_SEQUENTIAL);
+    std::memcpy(&header_, data_, sizeof(header_));
+    if (header_.magic != ITERATION_FILE_MAGIC or header_.tile_size == 0 or
+        header_.samples_per_side == 0 or header_.file_size() != size_) {
+      ::munmap(data_, size_);
+      throw std::runtime_error("not an iteration file: " + path.string());
+    }
+  }
+  iteration_file(iteration_file const &) = delete;
+  auto operator=(iteration_file const &) -> iteration_file & = delete;
+  ~iteration_file() { ::munmap(data_, size_); }
+
+  [[nodiscard]] auto header() const -> iteration_file_header const & { return header_; }
+
+  /// Smooth counts of tile (tx, ty), tile_samples() squared, row-major.
+  [[nodiscard]] auto tile(std::size_t tx, std::size_t ty) const -> std::span<float const> {
+    auto const count = header_.tile_samples() * header_.tile_samples();
+    auto const *first = reinterpret_cast<float const *>(
+        static_cast<std::byte const *>(data_) + sizeof(iteration_file_header)
+    );
+    return {first + (ty * header_.tiles_x() + tx) * count, count};
+  }
+
+private:
+  void *data_ = nullptr;
+  std::size_t size_{};
+  iteration_file_header header_;
+};
+
+namespace colour {
+
+/// Colours tile row `ty` of `file` into `band` (the image width, one tile high or what is left
+/// of the image), one tile per work item: every sample goes through `pal` and each pixel gets
+/// the mean of its samples, as in shade.
+template <std::size_t MAX_ITER>
+void recolour(
+    iteration_file const &file,
+    std::size_t ty,
+    palette const &pal,
+    auto scheduler,
+    rgb_image &band
+) {
+  constexpr auto lanes = batch::size;
+  auto const &h = file.header();
+  auto const n = std::size_t{h.samples_per_side};
+  auto const side = h.tile_samples();
+  auto const top = ty * h.tile_size;
+  band.resize(h.width, std::min<std::size_t>(h.tile_size, h.height - top));
+  auto const inv_samples = 1.0 / static_cast<double>(n * n);
+
+  parallel_for(scheduler, h.tiles_x(), [&](std::size_t tx) {
+    alignas(alignof(batch)) double count_buf[lanes];
+    alignas(alignof(batch)) double r_buf[lanes];
+    alignas(alignof(batch)) double g_buf[lanes];
+    alignas(alignof(batch)) double b_buf[lanes];
+    auto const counts = file.tile(tx, ty);
+    auto const left = tx * h.tile_size;
+    auto const width = std::min<std::size_t>(h.tile_size, h.width - left);
+    auto acc = std::vector<double>(h.tile_size * 3);
+
+    for (std::size_t py = 0; py != band.height; ++py) {
+      std::fill(acc.begin(), acc.end(), 0.0);
+      for (std::size_t sy = 0; sy != n; ++sy) {
+        // Tiles are padded, and whole batches wide
+        auto const *row = counts.data() + (py * n + sy) * side;
+        for (std::size_t sx = 0; sx < width * n; sx += lanes) {
+          for (std::size_t lane = 0; lane != lanes; ++lane) {
+            count_buf[lane] = row[sx + lane];
+          }
+          auto const [r, g, b] = pal.sample(normalized<MAX_ITER>(batch::load_aligned(count_buf)));
+          r.store_aligned(r_buf);
+          g.store_aligned(g_buf);
+          b.store_aligned(b_buf);
+          for (std::size_t lane = 0; lane != lanes; ++lane) {
+            auto const px = (sx + lane) / n;
+            acc[px * 3 + 0] += r_buf[lane];
+            acc[px * 3 + 1] += g_buf[lane];
+            acc[px * 3 + 2] += b_buf[lane];
+          }
+        }
+      }
+      auto *out = band.row(py).data() + left * 3;
+      for (std::size_t i = 0; i != width * 3; ++i) {
+        out[i] = static_cast<std::uint8_t>(std::clamp(255.0 * acc[i] * inv_samples, 0.0, 255.0));
+      }
+    }
+  });
+}
+
+} // namespace colour
+
+} // namespace mandelbrot
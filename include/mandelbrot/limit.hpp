@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <utility>
+
+#include "mandelbrot/deepen.hpp"
+#include "mandelbrot/tile.hpp"
+
+namespace mandelbrot::tile {
+
+/// Pixels along the longer side of the probe choose_limit renders.
+inline constexpr std::size_t LIMIT_PROBE_SIZE = 64;
+/// Share of the probe that may escape only after the chosen limit, and so be shown as inside.
+inline constexpr double LIMIT_TOLERANCE = 0.002;
+/// Time a probe may spend climbing through the limits before it settles for the one it reached.
+inline constexpr std::chrono::duration<double> LIMIT_PROBE_BUDGET{0.05};
+
+/// The smallest of LIMITS (ascending) that a low-resolution probe of `vp` suggests is enough, read
+/// off the tail of the probe's escape count histogram. The probe is deepened through the limits
+/// in turn; once samples have started escaping, a limit is enough when raising it to the next
+/// frees no more than a share `tolerance` of the probe. A probe whose samples all escape stops at
+/// the limit that sees the last of them out, and one whose samples still inside are known_inside()
+/// at the limit it has reached, the smallest limit if none of them has escaped. Otherwise the probe
+/// climbs until `budget` is spent and takes the limit it got to.
+template <auto const &LIMITS>
+auto choose_limit(
+    viewport const &vp,
+    auto scheduler,
+    double tolerance = LIMIT_TOLERANCE,
+    std::chrono::duration<double> budget = LIMIT_PROBE_BUDGET
+) -> std::size_t {
+  auto const start = std::chrono::steady_clock::now();
+  auto const longer = std::max(vp.width, vp.height);
+  auto const side = [&](std::size_t n) {
+    return std::max<std::size_t>(1, n * LIMIT_PROBE_SIZE / longer);
+  };
+  auto const probe = viewport{vp.center_x, vp.center_y, vp.zoom, side(vp.width), side(vp.height)};
+  auto map = iteration_map{};
+  map.resize(probe.width, probe.height);
+  auto in = find_interior(map, 0); // Every sample, from z = 0
+  auto const allowed = static_cast<std::size_t>(tolerance * static_cast<double>(in.size()));
+
+  auto chosen = LIMITS.back();
+  auto escaped_before = std::size_t{0};
+  auto const step = [&]<std::size_t I>() {
+    constexpr auto limit = LIMITS[I];
+    deepen<limit>(probe, map, in, 0, in.size(), scheduler);
+    auto const escaped = settle(map, in, limit);
+    if (in.empty()) {
+      chosen = limit;
+      return true;
+    }
+    if (I != 0 and escaped_before != 0 and escaped <= allowed) {
+      chosen = LIMITS[I - 1];
+      return true;
+    }
+    escaped_before += escaped;
+    if (known_inside(probe, map, in)) {
+      chosen = escaped_before == 0 ? LIMITS.front() : limit;
+      return true;
+    }
+    if (std::chrono::steady_clock::now() - start >= budget) {
+      chosen = limit;
+      return true;
+    }
+    return false;
+  };
+  [&]<std::size_t... I>(std::index_sequence<I...>) {
+    static_cast<void>((step.template operator()<I>() or ...));
+  }(std::make_index_sequence<LIMITS.size()>{});
+  return chosen;
+}
+
+/// Brings a map rendered with a higher limit down to `limit`: samples that escaped only after
+/// more iterations are inside, as a render with `limit` leaves them.
+inline void lower_limit(iteration_map &map, std::size_t limit) {
+  for (std::size_t i = 0; i != map.iter.size(); ++i) {
+    if (map.iter[i] > limit) {
+      map.iter[i] = limit;
+      map.mag[i] = 0.0;
+      map.forget_orbits(i, i + 1);
+    }
+  }
+}
+
+} // namespace mandelbrot::tile
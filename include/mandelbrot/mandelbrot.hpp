@@ -12,4 +12,33 @@
 #include "mandelbrot/v7.hpp"
 
 // MT (+ SIMD)
+#include "mandelbrot/backend.hpp"
 #include "mandelbrot/v8.hpp"
+
+// Tiles (MT + SIMD)
+#include "mandelbrot/balance.hpp"
+#include "mandelbrot/governor.hpp"
+#include "mandelbrot/deepen.hpp"
+#include "mandelbrot/limit.hpp"
+#include "mandelbrot/render.hpp"
+
+// Colour
+#include "mandelbrot/colour.hpp"
+
+// Anti-aliasing
+#include "mandelbrot/adaptive.hpp"
+#include "mandelbrot/temporal.hpp"
+
+// Caching
+#include "mandelbrot/cache.hpp"
+#include "mandelbrot/store.hpp"
+
+// Output
+#include "mandelbrot/checkpoint.hpp"
+#include "mandelbrot/image.hpp"
+#include "mandelbrot/iterfile.hpp"
+#include "mandelbrot/qoi.hpp"
+#include "mandelbrot/queue.hpp"
+
+// Zoom videos
+#include "mandelbrot/expmap.hpp"
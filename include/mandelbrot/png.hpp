@@ -0,0 +1,256 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include <zlib.h>
+
+#include "mandelbrot/backend.hpp"
+#include "mandelbrot/image.hpp"
+
+// PNG output needs zlib, so unlike the other headers this one is not part of mandelbrot.hpp.
+
+namespace mandelbrot {
+
+namespace {
+
+void append_be32(std::vector<std::uint8_t> &out, std::uint32_t v) {
+  out.push_back(static_cast<std::uint8_t>(v >> 24));
+  out.push_back(static_cast<std::uint8_t>(v >> 16));
+  out.push_back(static_cast<std::uint8_t>(v >> 8));
+  out.push_back(static_cast<std::uint8_t>(v));
+}
+
+[[nodiscard]] auto read_be32(std::uint8_t const *p) -> std::uint32_t {
+  return static_cast<std::uint32_t>(p[0]) << 24 | static_cast<std::uint32_t>(p[1]) << 16 |
+         static_cast<std::uint32_t>(p[2]) << 8 | static_cast<std::uint32_t>(p[3]);
+}
+
+void append_chunk(
+    std::vector<std::uint8_t> &out,
+    std::string_view type,
+    std::span<std::uint8_t const> data
+) {
+  append_be32(out, static_cast<std::uint32_t>(data.size()));
+  auto const start = out.size();
+  out.insert(out.end(), type.begin(), type.end());
+  out.insert(out.end(), data.begin(), data.end());
+  auto const crc = crc32(0, out.data() + start, static_cast<uInt>(out.size() - start));
+  append_be32(out, static_cast<std::uint32_t>(crc));
+}
+
+/// Scanlines as PNG stores them before compression, each behind its filter type byte.
+[[nodiscard]] auto png_scanlines(rgb_image const &image) -> std::vector<std::uint8_t> {
+  auto const stride = image.width * 3 + 1;
+  auto raw = std::vector<std::uint8_t>(stride * image.height);
+  for (std::size_t y = 0; y != image.height; ++y) {
+    auto const row = image.row(y);
+    raw[y * stride] = 0; // Filter type: none
+    std::copy(row.begin(), row.end(), raw.begin() + y * stride + 1);
+  }
+  return raw;
+}
+
+/// Signature, IHDR for 8-bit RGB, one IDAT holding `zlib_stream`, IEND.
+[[nodiscard]] auto png_file(rgb_image const &image, std::span<std::uint8_t const> zlib_stream)
+    -> std::vector<std::uint8_t> {
+  auto out = std::vector<std::uint8_t>{0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+  auto header = std::vector<std::uint8_t>{};
+  append_be32(header, static_cast<std::uint32_t>(image.width));
+  append_be32(header, static_cast<std::uint32_t>(image.height));
+  header.insert(header.end(), {8, 2, 0, 0, 0}); // 8-bit RGB, deflate, no interlace
+  append_chunk(out, "IHDR", header);
+  append_chunk(out, "IDAT", zlib_stream);
+  append_chunk(out, "IEND", {});
+  return out;
+}
+
+/// Raw deflate of `data`, primed with up to a window of the bytes before it in `preceding`, ending
+/// on a byte boundary (Z_SYNC_FLUSH) so that blocks can be concatenated, or finishing the stream.
+[[nodiscard]] auto deflate_block(
+    std::span<std::uint8_t const> preceding,
+    std::span<std::uint8_t const> data,
+    int level,
+    bool last
+) -> std::vector<std::uint8_t> {
+  constexpr std::size_t window = 1 << 15;
+  auto stream = z_stream{};
+  if (deflateInit2(&stream, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw std::runtime_error("PNG compression failed");
+  }
+  auto const dictionary = preceding.last(std::min(window, preceding.size()));
+  if (not dictionary.empty()) {
+    deflateSetDictionary(&stream, dictionary.data(), static_cast<uInt>(dictionary.size()));
+  }
+  // Room for the worst case plus the empty stored block a sync flush ends with
+  auto out = std::vector<std::uint8_t>(deflateBound(&stream, static_cast<uLong>(data.size())) + 16);
+  stream.next_in = const_cast<Bytef *>(data.data());
+  stream.avail_in = static_cast<uInt>(data.size());
+  stream.next_out = out.data();
+  stream.avail_out = static_cast<uInt>(out.size());
+  auto const result = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+  auto const done = last ? result == Z_STREAM_END : result == Z_OK and stream.avail_in == 0;
+  out.resize(stream.total_out);
+  deflateEnd(&stream);
+  if (not done) {
+    throw std::runtime_error("PNG compression failed");
+  }
+  return out;
+}
+
+} // namespace
+
+/// Raw scanline bytes deflated per work item by the parallel PNG encoder.
+inline constexpr std::size_t PNG_BLOCK_BYTES = 1 << 18;
+
+/// 8-bit RGB PNG, every scanline unfiltered, deflated at `level`.
+[[nodiscard]] inline auto encode_png(rgb_image const &image, int level = Z_DEFAULT_COMPRESSION)
+    -> std::vector<std::uint8_t> {
+  auto const raw = png_scanlines(image);
+  auto deflated = std::vector<std::uint8_t>(compressBound(static_cast<uLong>(raw.size())));
+  auto deflated_size = static_cast<uLongf>(deflated.size());
+  if (compress2(deflated.data(), &deflated_size, raw.data(), raw.size(), level) != Z_OK) {
+    throw std::runtime_error("PNG compression failed");
+  }
+  deflated.resize(deflated_size);
+  return png_file(image, deflated);
+}
+
+/// As encode_png, with blocks of rows deflated in parallel on `scheduler`. Each block is primed
+/// with the window before it and sync-flushed, so the blocks concatenate into one zlib stream
+/// that compresses almost as well as a serial one.
+[[nodiscard]] inline auto encode_png(
+    rgb_image const &image,
+    auto scheduler,
+    int level = Z_DEFAULT_COMPRESSION
+) -> std::vector<std::uint8_t> {
+  auto const raw = png_scanlines(image);
+  auto const stride = image.width * 3 + 1;
+  auto const rows = std::max<std::size_t>(1, PNG_BLOCK_BYTES / stride);
+  auto const blocks = std::max<std::size_t>(1, (image.height + rows - 1) / rows);
+  auto const block = [&](std::size_t i) {
+    auto const begin = std::min(i * rows, image.height) * stride;
+    auto const end = std::min((i + 1) * rows, image.height) * stride;
+    return std::span(raw).subspan(begin, end - begin);
+  };
+  auto deflated = std::vector<std::vector<std::uint8_t>>(blocks);
+  auto checksums = std::vector<uLong>(blocks);
+  parallel_for(scheduler, blocks, [&](std::size_t i) {
+    auto const data = block(i);
+    auto const preceding = std::span(raw).first(static_cast<std::size_t>(data.data() - raw.data()));
+    deflated[i] = deflate_block(preceding, data, level, i + 1 == blocks);
+    checksums[i] = adler32(adler32(0, nullptr, 0), data.data(), static_cast<uInt>(data.size()));
+  });
+
+  // zlib header (deflate, 32K window, level hint) and trailer (Adler-32 of everything)
+  auto const level_hint = level < 0 or level == 6 ? 2 : level < 2 ? 0 : level < 6 ? 1 : 3;
+  auto const flags = level_hint << 6;
+  auto stream = std::vector<std::uint8_t>{
+      0x78, static_cast<std::uint8_t>(flags + 31 - (0x78 * 256 + flags) % 31)
+  };
+  auto checksum = adler32(0, nullptr, 0);
+  for (std::size_t i = 0; i != blocks; ++i) {
+    stream.insert(stream.end(), deflated[i].begin(), deflated[i].end());
+    checksum = adler32_combine(checksum, checksums[i], static_cast<z_off_t>(block(i).size()));
+  }
+  append_be32(stream, static_cast<std::uint32_t>(checksum));
+  return png_file(image, stream);
+}
+
+inline void write_png(std::filesystem::path const &path, rgb_image const &image) {
+  write_bytes(path, encode_png(image));
+}
+
+inline void write_png(std::filesystem::path const &path, rgb_image const &image, auto scheduler) {
+  write_bytes(path, encode_png(image, scheduler));
+}
+
+/// Decodes an 8-bit RGB, non-interlaced PNG such as encode_png writes; throws on anything else.
+[[nodiscard]] inline auto decode_png(std::span<std::uint8_t const> bytes) -> rgb_image {
+  constexpr std::uint8_t signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+  auto const fail = [] { return std::runtime_error("unsupported or corrupt PNG"); };
+  if (bytes.size() < 8 or not std::equal(signature, signature + 8, bytes.begin())) {
+    throw fail();
+  }
+  auto image = rgb_image{};
+  auto deflated = std::vector<std::uint8_t>{};
+  for (std::size_t pos = 8; pos + 12 <= bytes.size();) {
+    auto const length = std::size_t{read_be32(bytes.data() + pos)};
+    auto const type = std::string_view(reinterpret_cast<char const *>(bytes.data() + pos + 4), 4);
+    auto const data = bytes.data() + pos + 8;
+    if (pos + 12 + length > bytes.size()) {
+      throw fail();
+    }
+    if (type == "IHDR") {
+      if (length != 13 or data[8] != 8 or data[9] != 2 or data[12] != 0) {
+        throw fail();
+      }
+      image.resize(read_be32(data), read_be32(data + 4));
+    } else if (type == "IDAT") {
+      deflated.insert(deflated.end(), data, data + length);
+    } else if (type == "IEND") {
+      break;
+    }
+    pos += 12 + length;
+  }
+
+  auto const stride = image.width * 3;
+  auto raw = std::vector<std::uint8_t>((stride + 1) * image.height);
+  auto raw_size = static_cast<uLongf>(raw.size());
+  if (image.width == 0 or
+      uncompress(raw.data(), &raw_size, deflated.data(), deflated.size()) != Z_OK or
+      raw_size != raw.size()) {
+    throw fail();
+  }
+  // Undo the per-scanline filters against the previous, already unfiltered row
+  auto const zero = std::vector<std::uint8_t>(stride);
+  for (std::size_t y = 0; y != image.height; ++y) {
+    auto const filter = raw[y * (stride + 1)];
+    auto const *in = raw.data() + y * (stride + 1) + 1;
+    auto const *up = y == 0 ? zero.data() : image.row(y - 1).data();
+    auto *out = image.row(y).data();
+    for (std::size_t i = 0; i != stride; ++i) {
+      int const a = i >= 3 ? out[i - 3] : 0;
+      int const b = up[i];
+      int const c = i >= 3 ? up[i - 3] : 0;
+      auto predictor = 0;
+      switch (filter) {
+      case 0: break;
+      case 1: predictor = a; break;
+      case 2: predictor = b; break;
+      case 3: predictor = (a + b) / 2; break;
+      case 4: {
+        auto const p = a + b - c;
+        auto const pa = std::abs(p - a);
+        auto const pb = std::abs(p - b);
+        auto const pc = std::abs(p - c);
+        predictor = pa <= pb and pa <= pc ? a : pb <= pc ? b : c;
+        break;
+      }
+      default: throw fail();
+      }
+      out[i] = static_cast<std::uint8_t>(in[i] + predictor);
+    }
+  }
+  return image;
+}
+
+[[nodiscard]] inline auto read_png(std::filesystem::path const &path) -> rgb_image {
+  auto in = std::ifstream(path, std::ios::binary);
+  auto const bytes = std::vector<std::uint8_t>(std::istreambuf_iterator<char>(in), {});
+  if (not in and not in.eof()) {
+    throw std::runtime_error("cannot read " + path.string());
+  }
+  return decode_png(bytes);
+}
+
+} // namespace mandelbrot
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "mandelbrot/backend.hpp"
+#include "mandelbrot/image.hpp"
+
+namespace mandelbrot {
+
+namespace qoi {
+
+struct pixel {
+  std::uint8_t r{};
+  std::uint8_t g{};
+  std::uint8_t b{};
+  std::uint8_t a{};
+
+  auto operator==(pixel const &) const -> bool = default;
+};
+
+[[nodiscard]] inline auto hash(pixel const &p) -> std::size_t {
+  return (p.r * 3u + p.g * 5u + p.b * 7u + p.a * 11u) % 64u;
+}
+
+/// Encodes pixels [begin, end) of `image` as QOI chunks onto `out`, starting from the state a
+/// decoder has after pixel begin - 1 apart from its colour index, which starts empty. A decoder's
+/// index only ever holds more than ours, never anything different in a slot we reference, so
+/// ranges encoded this way can be concatenated. Runs are flushed at `end`.
+inline void encode_range(
+    rgb_image const &image,
+    std::size_t begin,
+    std::size_t end,
+    std::vector<std::uint8_t> &out
+) {
+  auto const at = [&](std::size_t i) {
+    auto const *p = image.pixels.data() + i * 3;
+    return pixel{p[0], p[1], p[2], 255};
+  };
+  auto index = std::array<pixel, 64>{};
+  auto previous = begin == 0 ? pixel{0, 0, 0, 255} : at(begin - 1);
+  std::uint8_t run = 0;
+  for (auto i = begin; i != end; ++i) {
+    auto const p = at(i);
+    if (p == previous) {
+      if (++run == 62) {
+        out.push_back(0xc0 | (run - 1)); // QOI_OP_RUN
+        run = 0;
+      }
+      continue;
+    }
+    if (run != 0) {
+      out.push_back(0xc0 | (run - 1));
+      run = 0;
+    }
+    auto const slot = hash(p);
+    if (index[slot] == p) {
+      out.push_back(static_cast<std::uint8_t>(slot)); // QOI_OP_INDEX
+    } else {
+      index[slot] = p;
+      auto const dr = static_cast<std::int8_t>(p.r - previous.r);
+      auto const dg = static_cast<std::int8_t>(p.g - previous.g);
+      auto const db = static_cast<std::int8_t>(p.b - previous.b);
+      auto const dr_dg = dr - dg;
+      auto const db_dg = db - dg;
+      if (dr >= -2 and dr <= 1 and dg >= -2 and dg <= 1 and db >= -2 and db <= 1) {
+        out.push_back(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)); // QOI_OP_DIFF
+      } else if (dg >= -32 and dg <= 31 and dr_dg >= -8 and dr_dg <= 7 and db_dg >= -8 and
+                 db_dg <= 7) {
+        out.push_back(0x80 | (dg + 32)); // QOI_OP_LUMA
+        out.push_back(static_cast<std::uint8_t>((dr_dg + 8) << 4 | (db_dg + 8)));
+      } else {
+        out.insert(out.end(), {0xfe, p.r, p.g, p.b}); // QOI_OP_RGB
+      }
+    }
+    previous = p;
+  }
+  if (run != 0) {
+    out.push_back(0xc0 | (run - 1));
+  }
+}
+
+inline void append_header(rgb_image const &image, std::vector<std::uint8_t> &out) {
+  out.insert(out.end(), {'q', 'o', 'i', 'f'});
+  for (auto const v : {image.width, image.height}) {
+    for (auto shift = 24; shift >= 0; shift -= 8) {
+      out.push_back(static_cast<std::uint8_t>(v >> shift));
+    }
+  }
+  out.insert(out.end(), {3, 0}); // RGB, sRGB
+}
+
+inline void append_end_marker(std::vector<std::uint8_t> &out) {
+  out.insert(out.end(), {0, 0, 0, 0, 0, 0, 0, 1});
+}
+
+} // namespace qoi
+
+/// Pixels encoded per work item by the parallel QOI encoder.
+inline constexpr std::size_t QOI_BLOCK_PIXELS = 1 << 16;
+
+/// QOI ("Quite OK Image"), lossless and several times faster to write than PNG.
+[[nodiscard]] inline auto encode_qoi(rgb_image const &image) -> std::vector<std::uint8_t> {
+  auto out = std::vector<std::uint8_t>{};
+  out.reserve(image.pixels.size() / 2);
+  qoi::append_header(image, out);
+  qoi::encode_range(image, 0, image.width * image.height, out);
+  qoi::append_end_marker(out);
+  return out;
+}
+
+/// As encode_qoi, with blocks of pixels encoded in parallel on `scheduler`. Each block starts
+/// with an empty colour index, which costs a few bytes per block.
+[[nodiscard]] inline auto encode_qoi(rgb_image const &image, auto scheduler)
+    -> std::vector<std::uint8_t> {
+  auto const pixels = image.width * image.height;
+  auto const blocks = (pixels + QOI_BLOCK_PIXELS - 1) / QOI_BLOCK_PIXELS;
+  auto encoded = std::vector<std::vector<std::uint8_t>>(blocks);
+  parallel_for(scheduler, blocks, [&](std::size_t i) {
+    encoded[i].reserve(QOI_BLOCK_PIXELS * 3 / 2);
+    qoi::encode_range(
+        image, i * QOI_BLOCK_PIXELS, std::min((i + 1) * QOI_BLOCK_PIXELS, pixels), encoded[i]
+    );
+  });
+  auto out = std::vector<std::uint8_t>{};
+  qoi::append_header(image, out);
+  for (auto const &block : encoded) {
+    out.insert(out.end(), block.begin(), block.end());
+  }
+  qoi::append_end_marker(out);
+  return out;
+}
+
+inline void write_qoi(std::filesystem::path const &path, rgb_image const &image) {
+  write_bytes(path, encode_qoi(image));
+}
+
+inline void write_qoi(std::filesystem::path const &path, rgb_image const &image, auto scheduler) {
+  write_bytes(path, encode_qoi(image, scheduler));
+}
+
+} // namespace mandelbrot
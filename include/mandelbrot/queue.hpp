@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mandelbrot {
+
+/// Blocking FIFO holding at most `capacity` items, for handing work between pipeline stages.
+template <typename T>
+class bounded_queue {
+public:
+  explicit bounded_queue(std::size_t capacity) : capacity_(capacity) {}
+
+  /// Waits for room; returns false (dropping `value`) once the queue is closed.
+  auto push(T value) -> bool {
+    auto lock = std::unique_lock{mutex_};
+    not_full_.wait(lock, [&] { return closed_ or items_.size() < capacity_; });
+    if (closed_) {
+      return false;
+    }
+    items_.push_back(std::move(value));
+    not_empty_.notify_one();
+    return true;
+  }
+
+  /// Waits for an item; empty once the queue is closed and drained.
+  [[nodiscard]] auto pop() -> std::optional<T> {
+    auto lock = std::unique_lock{mutex_};
+    not_empty_.wait(lock, [&] { return closed_ or not items_.empty(); });
+    if (items_.empty()) {
+      return std::nullopt;
+    }
+    auto value = std::move(items_.front());
+    items_.pop_front();
+    not_full_.notify_one();
+    return value;
+  }
+
+  /// Wakes every waiter; later pushes fail and pops drain what is left.
+  void close() {
+    auto const lock = std::lock_guard{mutex_};
+    closed_ = true;
+    not_full_.notify_all();
+    not_empty_.notify_all();
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+  std::deque<T> items_;
+  std::size_t capacity_;
+  bool closed_ = false;
+};
+
+/// Lock-free FIFO from any number of producers to a single consumer, holding at most `capacity`
+/// items (rounded up to a power of two). Neither side ever waits on a lock, so workers can hand
+/// results to a UI thread that polls once per frame. Each slot's sequence number says whose turn
+/// it is: a producer claims a position by compare-exchange and publishes the slot with a release
+/// store, which the consumer's acquire load pairs with.
+template <typename T>
+class completion_queue {
+public:
+  explicit completion_queue(std::size_t capacity)
+      : slots_(std::bit_ceil(std::max<std::size_t>(capacity, 2))), mask_(slots_.size() - 1) {
+    for (std::size_t i = 0; i != slots_.size(); ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /// Any thread. Returns false, leaving `value` alone, if the queue is full.
+  auto try_push(T &&value) -> bool {
+    auto pos = tail_.load(std::memory_order_relaxed);
+    while (true) {
+      auto &s = slots_[pos & mask_];
+      auto const sequence = s.sequence.load(std::memory_order_acquire);
+      if (sequence == pos) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          s.value = std::move(value);
+          s.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (sequence < pos) {
+        return false; // The slot still holds an item from one lap ago
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Any thread; yields while the queue is full, so the consumer must keep draining it.
+  void push(T value) {
+    while (not try_push(std::move(value))) {
+      std::this_thread::yield();
+    }
+  }
+
+  /// Consumer thread only. Empty if nothing is ready.
+  [[nodiscard]] auto try_pop() -> std::optional<T> {
+    auto &s = slots_[head_ & mask_];
+    if (s.sequence.load(std::memory_order_acquire) != head_ + 1) {
+      return std::nullopt;
+    }
+    auto value = std::move(s.value);
+    s.sequence.store(head_ + slots_.size(), std::memory_order_release);
+    ++head_;
+    return value;
+  }
+
+private:
+  struct slot {
+    std::atomic<std::size_t> sequence;
+    T value{};
+  };
+
+  std::vector<slot> slots_;
+  std::size_t mask_;
+  alignas(64) std::atomic<std::size_t> tail_{0};
+  alignas(64) std::size_t head_ = 0;
+};
+
+/// Makes items 0 .. count - 1 with `produce(i, item)` on `slots` threads and passes them in order
+/// to `consume(i, item)` on the calling thread. Item i is made by thread i % slots into that
+/// thread's own T, which comes back to it only once consumed, so at most `slots` items exist and a
+/// slow consumer holds the producers back. An exception on either side stops both and is rethrown.
+template <typename T>
+void ordered_pipeline(std::size_t count, std::size_t slots, auto &&produce, auto &&consume) {
+  auto empty = std::deque<bounded_queue<T>>{};
+  auto ready = std::deque<bounded_queue<T>>{};
+  for (std::size_t slot = 0; slot != slots; ++slot) {
+    empty.emplace_back(1).push(T{});
+    ready.emplace_back(1);
+  }
+  auto const close_all = [&] {
+    for (std::size_t slot = 0; slot != slots; ++slot) {
+      empty[slot].close();
+      ready[slot].close();
+    }
+  };
+  auto failure_mutex = std::mutex{};
+  auto failure = std::exception_ptr{};
+
+  auto producers = std::vector<std::jthread>{};
+  for (std::size_t slot = 0; slot != slots; ++slot) {
+    producers.emplace_back([&, slot] {
+      try {
+        for (auto i = slot; i < count; i += slots) {
+          auto item = empty[slot].pop();
+          if (not item) {
+            return;
+          }
+          produce(i, *item);
+          if (not ready[slot].push(std::move(*item))) {
+            return;
+          }
+        }
+      } catch (...) {
+        auto const lock = std::lock_guard{failure_mutex};
+        failure = std::current_exception();
+        close_all();
+      }
+    });
+  }
+
+  try {
+    for (std::size_t i = 0; i != count; ++i) {
+      auto item = ready[i % slots].pop();
+      if (not item) {
+        break;
+      }
+      consume(i, *item);
+      empty[i % slots].push(std::move(*item));
+    }
+  } catch (...) {
+    close_all();
+    throw;
+  }
+  producers.clear();
+  if (failure) {
+    std::rethrow_exception(failure);
+  }
+}
+
+} // namespace mandelbrot
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "mandelbrot/boundary.hpp"
+#include "mandelbrot/subdivide.hpp"
+#include "mandelbrot/tile.hpp"
+
+namespace mandelbrot::tile {
+
+enum class strategy : int { brute_force = 0, subdivide, boundary_trace, count };
+
+[[nodiscard]] constexpr auto to_string(strategy s) -> std::string_view {
+  switch (s) {
+  case strategy::brute_force: return "Per-pixel";
+  case strategy::subdivide: return "Mariani-Silver";
+  case strategy::boundary_trace: return "Boundary trace";
+  case strategy::count: break;
+  }
+  return "Unknown";
+}
+
+/// Fills the pixels of `region` in an already sized `map`; returns the number of pixels actually
+/// iterated. `fill` is what the shortcut strategies may fill, which must suit the colouring.
+/// `on_tile` hears of each finished piece from the worker that finished it.
+template <std::size_t MAX_ITER, typename OnTile = ignore_tile>
+auto render_region(
+    viewport const &vp,
+    iteration_map &map,
+    rect region,
+    auto scheduler,
+    strategy s = strategy::brute_force,
+    fill_mode fill = fill_mode::bands,
+    OnTile on_tile = {}
+) -> std::size_t {
+  switch (s) {
+  case strategy::subdivide:
+    return render_subdivide<MAX_ITER>(vp, map, scheduler, region, fill, on_tile);
+  case strategy::boundary_trace:
+    return render_boundary_trace<MAX_ITER>(vp, map, scheduler, region, fill, on_tile);
+  case strategy::brute_force:
+  case strategy::count: break;
+  }
+  return render_brute_force<MAX_ITER>(vp, map, scheduler, region, on_tile);
+}
+
+/// Fills `map` for the whole viewport; returns the number of pixels actually iterated.
+template <std::size_t MAX_ITER, typename OnTile = ignore_tile>
+auto render(
+    viewport const &vp,
+    iteration_map &map,
+    auto scheduler,
+    strategy s = strategy::brute_force,
+    fill_mode fill = fill_mode::bands,
+    OnTile on_tile = {}
+) -> std::size_t {
+  map.resize(vp.width, vp.height);
+  return render_region<MAX_ITER>(
+      vp, map, {0, 0, vp.width, vp.height}, scheduler, s, fill, on_tile
+  );
+}
+
+} // namespace mandelbrot::tile
@@ -0,0 +1,653 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mandelbrot/cache.hpp"
+
+namespace mandelbrot::tile {
+
+namespace detail {
+
+inline constexpr std::uint64_t STORE_MAGIC = 0x31454C49'54424D4DULL; // "MMBTILE1"
+inline constexpr std::size_t STORE_GROW = std::size_t{64} << 20;
+inline constexpr std::size_t STORE_RECENT_LIMIT = 256;
+inline constexpr std::size_t STORE_SYNC_BATCH = 64;
+inline constexpr std::size_t STORE_QUEUE_LIMIT = 256; // Tiles waiting for the writer thread
+
+/// Data file record header; the payload follows as width * height iteration counts, then as
+/// many magnitudes.
+struct record_header {
+  std::uint64_t magic;
+  std::int64_t x;
+  std::int64_t y;
+  std::uint64_t max_iter;
+  std::int32_t level;
+  std::uint32_t formula;
+  std::uint32_t samples_per_side;
+  std::uint32_t width;
+  std::uint32_t height;
+  std::uint32_t reserved;
+  std::uint64_t checksum; // Of the payload
+};
+static_assert(sizeof(record_header) == 64);
+
+struct index_record {
+  std::int64_t x;
+  std::int64_t y;
+  std::uint64_t max_iter;
+  std::int32_t level;
+  std::uint32_t formula;
+  std::uint32_t samples_per_side;
+  std::uint32_t reserved;
+  std::uint64_t offset;
+};
+static_assert(sizeof(index_record) == 48);
+
+/// Data file sizes are whole STORE_GROW chunks, at least one.
+[[nodiscard]] inline auto round_to_chunk(std::size_t size) -> std::size_t {
+  return std::max(STORE_GROW, (size + STORE_GROW - 1) / STORE_GROW * STORE_GROW);
+}
+
+[[noreturn]] inline void throw_errno(char const *what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+/// FNV-1a over 64-bit words; payloads are always a whole number of words.
+[[nodiscard]] inline auto checksum(std::span<std::byte const> bytes) -> std::uint64_t {
+  auto h = std::uint64_t{0xcbf29ce484222325};
+  for (std::size_t i = 0; i + sizeof(std::uint64_t) <= bytes.size(); i += sizeof(std::uint64_t)) {
+    auto word = std::uint64_t{};
+    std::memcpy(&word, bytes.data() + i, sizeof(word));
+    h = (h ^ word) * 0x100000001b3;
+  }
+  return h;
+}
+
+[[nodiscard]] inline auto key_of(record_header const &h) -> tile_key {
+  return {h.level, h.x, h.y, h.max_iter, h.formula, h.samples_per_side};
+}
+
+[[nodiscard]] inline auto key_of(index_record const &r) -> tile_key {
+  return {r.level, r.x, r.y, r.max_iter, r.formula, r.samples_per_side};
+}
+
+[[nodiscard]] inline auto record_size(std::size_t width, std::size_t height) -> std::size_t {
+  return sizeof(record_header) + width * height * (sizeof(std::uint64_t) + sizeof(double));
+}
+
+[[nodiscard]] inline auto index_entry(tile_key const &key, std::uint64_t offset) -> index_record {
+  return {key.x, key.y, key.max_iter, key.level, key.formula, key.samples_per_side, 0, offset};
+}
+
+inline void write_all(int fd, void const *data, std::size_t size, std::uint64_t offset) {
+  auto const *bytes = static_cast<std::byte const *>(data);
+  while (size != 0) {
+    auto const written = ::pwrite(fd, bytes, size, static_cast<off_t>(offset));
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw_errno("tile store write");
+    }
+    bytes += written;
+    size -= static_cast<std::size_t>(written);
+    offset += static_cast<std::uint64_t>(written);
+  }
+}
+
+/// Read-only shared mapping of the first `size` bytes of a file.
+class file_mapping {
+public:
+  file_mapping(int fd, std::size_t size) : size_(size) {
+    data_ = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (data_ == MAP_FAILED) {
+      throw_errno("tile store mmap");
+    }
+  }
+  file_mapping(file_mapping const &) = delete;
+  auto operator=(file_mapping const &) -> file_mapping & = delete;
+  ~file_mapping() { ::munmap(data_, size_); }
+
+  [[nodiscard]] auto bytes() const -> std::span<std::byte const> {
+    return {static_cast<std::byte const *>(data_), size_};
+  }
+
+private:
+  void *data_;
+  std::size_t size_;
+};
+
+/// Publishes immutable objects to readers that never wait. A reader pins the epoch it enters in
+/// with a per-parity counter and rechecks the epoch, so its count always belongs to an epoch no
+/// older than the object it reads. A writer (one at a time, serialised by the caller) swaps in a
+/// new object and retires the old one; objects retired in an epoch are freed when the epoch after
+/// next begins, which it may only once the counter of the epoch they were retired in is zero.
+/// Writers never wait for readers either: while readers linger, retired objects wait instead.
+template <typename T>
+class epoch_cell {
+public:
+  /// Keeps the object it was created with alive until it is destroyed.
+  class pin {
+  public:
+    pin(std::atomic<std::size_t> &count, T const *object) : count_(&count), object_(object) {}
+    pin(pin const &) = delete;
+    auto operator=(pin const &) -> pin & = delete;
+    ~pin() { count_->fetch_sub(1); }
+
+    [[nodiscard]] auto get() const -> T const * { return object_; }
+    auto operator->() const -> T const * { return object_; }
+
+  private:
+    std::atomic<std::size_t> *count_;
+    T const *object_;
+  };
+
+  epoch_cell() = default;
+  epoch_cell(epoch_cell const &) = delete;
+  auto operator=(epoch_cell const &) -> epoch_cell & = delete;
+  ~epoch_cell() {
+    delete current_.load();
+    release(retired_);
+    release(previous_);
+  }
+
+  [[nodiscard]] auto read() const -> pin {
+    while (true) {
+      auto const epoch = epoch_.load();
+      auto &count = readers_[epoch & 1];
+      count.fetch_add(1);
+      if (epoch_.load() == epoch) {
+        return pin(count, current_.load());
+      }
+      count.fetch_sub(1);
+    }
+  }
+
+  /// The current object, for the writer only.
+  [[nodiscard]] auto get() const -> T const * { return current_.load(std::memory_order_relaxed); }
+
+  void publish(std::unique_ptr<T const> next) {
+    retired_.push_back(current_.exchange(next.release()));
+    auto const epoch = epoch_.load();
+    // Readers of the previous epoch are the last that can hold what it retired
+    if (readers_[(epoch + 1) & 1].load() == 0) {
+      release(previous_);
+      previous_ = std::exchange(retired_, {});
+      epoch_.store(epoch + 1);
+    }
+  }
+
+private:
+  static void release(std::vector<T const *> &objects) {
+    for (auto const *object : objects) {
+      delete object;
+    }
+    objects.clear();
+  }
+
+  std::atomic<T const *> current_{nullptr};
+  std::atomic<std::uint64_t> epoch_{0};
+  alignas(64) mutable std::array<std::atomic<std::size_t>, 2> readers_{};
+  std::vector<T const *> retired_;  // Replaced in this epoch
+  std::vector<T const *> previous_; // Replaced in the epoch before
+};
+
+} // namespace detail
+
+/// Persistent tile store: an append-only, memory-mapped data file plus an index file.
+///
+/// Records carry a checksum and are synced to disk before their index entries are written, in
+/// batches, so a crash loses at most the records after the last intact one. Checksums are checked
+/// when recovery scans for records the index lacks; indexed records were synced first. Readers
+/// never block: they work on an immutable snapshot of the index and mapping that the writer
+/// publishes through an epoch_cell.
+/// save() only queues a tile. One writer thread appends, syncs and, once the data file outgrows
+/// its capacity, rewrites it with the most recently used half, away from the threads rendering.
+class tile_store final : public tile_backing {
+public:
+  tile_store(std::filesystem::path const &directory, std::size_t capacity_bytes)
+      : directory_(directory), capacity_(capacity_bytes) {
+    std::filesystem::create_directories(directory_);
+    data_fd_ = open_file(data_path(), 0);
+    index_fd_ = open_file(index_path(), 0);
+    recover();
+    writer_ = std::jthread([this](std::stop_token stop) { write_queued(stop); });
+  }
+  tile_store(tile_store const &) = delete;
+  auto operator=(tile_store const &) -> tile_store & = delete;
+
+  ~tile_store() override {
+    // The writer drains the queue before it stops
+    writer_.request_stop();
+    writer_.join();
+    auto const lock = std::lock_guard{write_mutex_};
+    try {
+      commit_pending();
+    } catch (std::system_error const &) {
+      // The unindexed records are found again by the recovery scan
+    }
+    static_cast<void>(::ftruncate(data_fd_, static_cast<off_t>(end_.load())));
+    ::close(index_fd_);
+    ::close(data_fd_);
+  }
+
+  [[nodiscard]] auto load(tile_key const &key) -> tile_data override {
+    auto const snap = snapshots_.read();
+    auto const e = snap->find(key);
+    if (e == nullptr) {
+      return nullptr;
+    }
+    auto const used = clock_.fetch_add(1, std::memory_order_relaxed) + 1;
+    e->last_used.store(used, std::memory_order_relaxed);
+
+    auto const bytes = snap->mapping->bytes();
+    auto const header = read_header(bytes, bytes.size(), e->offset, false);
+    if (not header or detail::key_of(*header) != key) {
+      return nullptr;
+    }
+    auto const samples = std::size_t{header->width} * header->height;
+    auto const payload = bytes.subspan(e->offset + sizeof(record_header));
+    auto tile = std::make_shared<iteration_map>();
+    tile->resize(header->width, header->height);
+    for (std::size_t i = 0; i != samples; ++i) {
+      auto iter = std::uint64_t{};
+      std::memcpy(&iter, payload.data() + i * sizeof(iter), sizeof(iter));
+      tile->iter[i] = static_cast<std::size_t>(iter);
+    }
+    std::memcpy(
+        tile->mag.data(), payload.data() + samples * sizeof(std::uint64_t), samples * sizeof(double)
+    );
+    return tile;
+  }
+
+  /// Queues `tile` for the writer thread. Best effort: a tile that cannot be written, or arrives
+  /// while the queue is full, is simply not persisted.
+  void save(tile_key const &key, tile_data tile) override {
+    auto const lock = std::lock_guard{queue_mutex_};
+    if (queue_.size() >= detail::STORE_QUEUE_LIMIT) {
+      return;
+    }
+    queue_.emplace_back(key, std::move(tile));
+    queued_.notify_one();
+  }
+
+  /// Makes every saved tile durable.
+  void flush() {
+    {
+      auto lock = std::unique_lock{queue_mutex_};
+      drained_.wait(lock, [&] { return queue_.empty() and not writing_; });
+    }
+    auto const lock = std::lock_guard{write_mutex_};
+    commit_pending();
+  }
+
+  [[nodiscard]] auto size_bytes() const -> std::size_t { return end_.load(); }
+  [[nodiscard]] auto tile_count() const -> std::size_t {
+    return snapshots_.read()->size();
+  }
+
+private:
+  using record_header = detail::record_header;
+  using index_record = detail::index_record;
+  using file_mapping = detail::file_mapping;
+
+  struct entry {
+    entry(std::uint64_t o, std::uint64_t used) : offset(o), last_used(used) {}
+    std::uint64_t offset;
+    std::atomic<std::uint64_t> last_used;
+  };
+  using entry_ptr = std::shared_ptr<entry>;
+  using entry_map = std::unordered_map<tile_key, entry_ptr, tile_key_hash>;
+
+  /// What readers see: the mapping plus an index split into a large shared base and a short
+  /// list of recent additions, so publishing a new tile copies only the short list.
+  struct snapshot {
+    std::shared_ptr<file_mapping const> mapping;
+    std::shared_ptr<entry_map const> base = std::make_shared<entry_map const>();
+    std::vector<std::pair<tile_key, entry_ptr>> recent;
+
+    [[nodiscard]] auto find(tile_key const &key) const -> entry * {
+      for (auto it = recent.rbegin(); it != recent.rend(); ++it) {
+        if (it->first == key) {
+          return it->second.get();
+        }
+      }
+      auto const it = base->find(key);
+      return it != base->end() ? it->second.get() : nullptr;
+    }
+    void add(tile_key const &key, entry_ptr e) {
+      recent.emplace_back(key, std::move(e));
+      if (recent.size() >= detail::STORE_RECENT_LIMIT) {
+        auto merged = std::make_shared<entry_map>(*base);
+        merged->insert(recent.begin(), recent.end());
+        base = std::move(merged);
+        recent.clear();
+      }
+    }
+    [[nodiscard]] auto size() const -> std::size_t { return base->size() + recent.size(); }
+  };
+
+  /// The writer thread: appends queued tiles until stopped with the queue empty.
+  void write_queued(std::stop_token stop) {
+    while (true) {
+      auto lock = std::unique_lock{queue_mutex_};
+      queued_.wait(lock, stop, [&] { return not queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+      auto const [key, tile] = std::move(queue_.front());
+      queue_.pop_front();
+      writing_ = true;
+      lock.unlock();
+      {
+        auto const write_lock = std::lock_guard{write_mutex_};
+        if (snapshots_.get()->find(key) == nullptr) {
+          try {
+            append(key, *tile);
+          } catch (std::exception const &) {
+            // Best effort, as documented on save()
+          }
+        }
+      }
+      lock.lock();
+      writing_ = false;
+      if (queue_.empty()) {
+        drained_.notify_all();
+      }
+    }
+  }
+
+  /// Writes one record and shows it to readers at once; durability follows in batches.
+  void append(tile_key const &key, iteration_map const &tile) {
+    auto const samples = tile.width * tile.height;
+    auto record = std::vector<std::byte>(detail::record_size(tile.width, tile.height));
+    auto *payload = record.data() + sizeof(record_header);
+    for (std::size_t i = 0; i != samples; ++i) {
+      auto const iter = static_cast<std::uint64_t>(tile.iter[i]);
+      std::memcpy(payload + i * sizeof(iter), &iter, sizeof(iter));
+    }
+    std::memcpy(
+        payload + samples * sizeof(std::uint64_t), tile.mag.data(), samples * sizeof(double)
+    );
+    auto const header = record_header{
+        detail::STORE_MAGIC,
+        key.x,
+        key.y,
+        key.max_iter,
+        key.level,
+        key.formula,
+        key.samples_per_side,
+        static_cast<std::uint32_t>(tile.width),
+        static_cast<std::uint32_t>(tile.height),
+        0,
+        detail::checksum({payload, record.size() - sizeof(record_header)})
+    };
+    std::memcpy(record.data(), &header, sizeof(header));
+
+    auto const offset = end_.load();
+    reserve(end_ + record.size());
+    detail::write_all(data_fd_, record.data(), record.size(), offset);
+    end_ += record.size();
+    pending_.push_back(detail::index_entry(key, offset));
+
+    auto next = std::make_unique<snapshot>(*snapshots_.get());
+    next->add(key, std::make_shared<entry>(offset, clock_.fetch_add(1) + 1));
+    snapshots_.publish(std::move(next));
+
+    if (pending_.size() >= detail::STORE_SYNC_BATCH) {
+      commit_pending();
+    }
+    if (end_ > capacity_) {
+      compact();
+    }
+  }
+
+  [[nodiscard]] auto data_path() const -> std::filesystem::path {
+    return directory_ / "tiles.dat";
+  }
+  [[nodiscard]] auto index_path() const -> std::filesystem::path {
+    return directory_ / "tiles.idx";
+  }
+
+  [[nodiscard]] static auto open_file(std::filesystem::path const &path, int flags) -> int {
+    auto const fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | flags, 0644);
+    if (fd < 0) {
+      detail::throw_errno("tile store open");
+    }
+    return fd;
+  }
+
+  [[nodiscard]] static auto file_size(int fd) -> std::size_t {
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+      detail::throw_errno("tile store stat");
+    }
+    return static_cast<std::size_t>(st.st_size);
+  }
+
+  static void sync(int fd) {
+    if (::fdatasync(fd) != 0) {
+      detail::throw_errno("tile store sync");
+    }
+  }
+
+  /// Grows the (zero-filled) data file and its mapping to hold at least `size` bytes.
+  void reserve(std::size_t size) {
+    if (size <= mapped_) {
+      return;
+    }
+    auto const grown = detail::round_to_chunk(std::max(size, mapped_ * 2));
+    if (::ftruncate(data_fd_, static_cast<off_t>(grown)) != 0) {
+      detail::throw_errno("tile store resize");
+    }
+    mapped_ = grown;
+    auto next = std::make_unique<snapshot>(*snapshots_.get());
+    next->mapping = std::make_shared<file_mapping const>(data_fd_, mapped_);
+    snapshots_.publish(std::move(next));
+  }
+
+  /// Syncs the records written since the last commit, then indexes them.
+  void commit_pending() {
+    if (pending_.empty()) {
+      return;
+    }
+    sync(data_fd_);
+    auto const bytes = pending_.size() * sizeof(index_record);
+    detail::write_all(index_fd_, pending_.data(), bytes, index_end_);
+    index_end_ += bytes;
+    pending_.clear();
+  }
+
+  /// The intact record at `offset` of the first `size` bytes of `bytes`, if there is one.
+  [[nodiscard]] static auto read_header(
+      std::span<std::byte const> bytes,
+      std::size_t size,
+      std::uint64_t offset,
+      bool verify
+  ) -> std::optional<record_header> {
+    if (offset + sizeof(record_header) > size) {
+      return std::nullopt;
+    }
+    auto header = record_header{};
+    std::memcpy(&header, bytes.data() + offset, sizeof(header));
+    auto const length = detail::record_size(header.width, header.height);
+    if (header.magic != detail::STORE_MAGIC or offset + length > size) {
+      return std::nullopt;
+    }
+    auto const payload = bytes.subspan(offset + sizeof(header), length - sizeof(header));
+    if (verify and detail::checksum(payload) != header.checksum) {
+      return std::nullopt;
+    }
+    return header;
+  }
+
+  /// Loads the index, checks it against the data file and picks up any records written after
+  /// the last indexed one. An index that disagrees with the data is rebuilt by a full scan.
+  void recover() {
+    auto const size = file_size(data_fd_);
+    mapped_ = detail::round_to_chunk(size);
+    if (size < mapped_ and ::ftruncate(data_fd_, static_cast<off_t>(mapped_)) != 0) {
+      detail::throw_errno("tile store resize");
+    }
+    auto snap = std::make_unique<snapshot>();
+    snap->mapping = std::make_shared<file_mapping const>(data_fd_, mapped_);
+    auto const bytes = snap->mapping->bytes();
+
+    auto records = std::vector<index_record>(file_size(index_fd_) / sizeof(index_record));
+    auto const index_bytes = records.size() * sizeof(index_record);
+    if (::pread(index_fd_, records.data(), index_bytes, 0) != static_cast<ssize_t>(index_bytes)) {
+      detail::throw_errno("tile store read");
+    }
+
+    auto entries = entry_map{};
+    auto end = std::uint64_t{};
+    auto indexed = true;
+    for (auto const &r : records) {
+      auto const header = read_header(bytes, size, r.offset, false);
+      if (not header or detail::key_of(*header) != detail::key_of(r)) {
+        indexed = false;
+        break;
+      }
+      entries.insert_or_assign(detail::key_of(r), std::make_shared<entry>(r.offset, ++clock_));
+      end = std::max(end, r.offset + detail::record_size(header->width, header->height));
+    }
+    if (not indexed) {
+      entries.clear();
+      records.clear();
+      end = 0;
+    }
+
+    // Records that never made it into the index (or all of them, when rebuilding)
+    while (auto const header = read_header(bytes, size, end, true)) {
+      auto const key = detail::key_of(*header);
+      records.push_back(detail::index_entry(key, end));
+      entries.insert_or_assign(key, std::make_shared<entry>(end, ++clock_));
+      end += detail::record_size(header->width, header->height);
+    }
+
+    if (::ftruncate(index_fd_, 0) != 0) {
+      detail::throw_errno("tile store resize");
+    }
+    sync(data_fd_);
+    detail::write_all(index_fd_, records.data(), records.size() * sizeof(index_record), 0);
+    index_end_ = records.size() * sizeof(index_record);
+    end_ = end;
+
+    snap->base = std::make_shared<entry_map const>(std::move(entries));
+    snapshots_.publish(std::move(snap));
+    if (end_ > capacity_) {
+      compact();
+    }
+  }
+
+  /// Rewrites the store with the most recently used tiles filling half of its capacity.
+  void compact() {
+    commit_pending();
+    auto const *old = snapshots_.get();
+    auto live = std::vector<std::pair<tile_key, entry *>>{};
+    live.reserve(old->size());
+    for (auto const &[key, e] : *old->base) {
+      live.emplace_back(key, e.get());
+    }
+    for (auto const &[key, e] : old->recent) {
+      live.emplace_back(key, e.get());
+    }
+    std::ranges::sort(live, std::greater{}, [](auto const &kv) {
+      return kv.second->last_used.load(std::memory_order_relaxed);
+    });
+
+    auto const data_tmp = std::filesystem::path(data_path()) += ".tmp";
+    auto const index_tmp = std::filesystem::path(index_path()) += ".tmp";
+    auto const data_fd = open_file(data_tmp, O_TRUNC);
+    auto const index_fd = open_file(index_tmp, O_TRUNC);
+    auto const bytes = old->mapping->bytes();
+    auto entries = entry_map{};
+    auto records = std::vector<index_record>{};
+    auto end = std::uint64_t{};
+    try {
+      for (auto const &[key, e] : live) {
+        auto header = record_header{};
+        std::memcpy(&header, bytes.data() + e->offset, sizeof(header));
+        auto const length = detail::record_size(header.width, header.height);
+        if (end + length > capacity_ / 2) {
+          break;
+        }
+        detail::write_all(data_fd, bytes.data() + e->offset, length, end);
+        records.push_back(detail::index_entry(key, end));
+        auto const used = e->last_used.load(std::memory_order_relaxed);
+        entries.emplace(key, std::make_shared<entry>(end, used));
+        end += length;
+      }
+      detail::write_all(index_fd, records.data(), records.size() * sizeof(index_record), 0);
+      sync(data_fd);
+      sync(index_fd);
+    } catch (...) {
+      ::close(data_fd);
+      ::close(index_fd);
+      throw;
+    }
+    // A crash between the renames leaves an index that fails validation and gets rebuilt
+    std::filesystem::rename(data_tmp, data_path());
+    std::filesystem::rename(index_tmp, index_path());
+
+    ::close(data_fd_);
+    ::close(index_fd_);
+    data_fd_ = data_fd;
+    index_fd_ = index_fd;
+    end_ = end;
+    index_end_ = records.size() * sizeof(index_record);
+    mapped_ = detail::round_to_chunk(end);
+    if (::ftruncate(data_fd_, static_cast<off_t>(mapped_)) != 0) {
+      detail::throw_errno("tile store resize");
+    }
+    auto next = std::make_unique<snapshot>();
+    next->mapping = std::make_shared<file_mapping const>(data_fd_, mapped_);
+    next->base = std::make_shared<entry_map const>(std::move(entries));
+    snapshots_.publish(std::move(next));
+  }
+
+  std::filesystem::path directory_;
+  std::size_t capacity_;
+  int data_fd_ = -1;
+  int index_fd_ = -1;
+  std::atomic<std::uint64_t> end_{}; // Of the last record in the data file
+  std::uint64_t index_end_{};        // Of the last committed index record
+  std::size_t mapped_{};
+  std::vector<index_record> pending_; // Written but not yet synced and indexed
+  std::mutex write_mutex_;
+  std::atomic<std::uint64_t> clock_{0};
+  detail::epoch_cell<snapshot> snapshots_;
+  std::mutex queue_mutex_;
+  std::condition_variable_any queued_;
+  std::condition_variable drained_;
+  std::deque<std::pair<tile_key, tile_data>> queue_; // Saved but not yet written
+  bool writing_ = false;                             // The writer holds a tile off the queue
+  std::jthread writer_;
+};
+
+} // namespace mandelbrot::tile
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+#include "mandelbrot/tile.hpp"
+
+namespace mandelbrot::tile {
+
+// Below this size splitting costs more than it saves, so the interior is evaluated directly.
+inline constexpr std::size_t SUBDIVIDE_MIN_SIZE = 6;
+
+namespace {
+
+[[nodiscard]] inline auto border_uniform(iteration_map const &map, rect r) -> bool {
+  auto const expected = map.iter[map.index(r.x, r.y)];
+  auto const right = r.x + r.width - 1;
+  auto const bottom = r.y + r.height - 1;
+  for (std::size_t x = r.x; x <= right; ++x) {
+    if (map.iter[map.index(x, r.y)] != expected or map.iter[map.index(x, bottom)] != expected) {
+      return false;
+    }
+  }
+  for (std::size_t y = r.y + 1; y < bottom; ++y) {
+    if (map.iter[map.index(r.x, y)] != expected or map.iter[map.index(right, y)] != expected) {
+      return false;
+    }
+  }
+  return true;
+}
+
+inline void fill_interior(iteration_map &map, rect r) {
+  auto const src = map.index(r.x, r.y);
+  auto const iter = map.iter[src];
+  auto const mag = map.mag[src];
+  for (std::size_t y = r.y + 1; y + 1 < r.y + r.height; ++y) {
+    auto const begin = map.index(r.x + 1, y);
+    auto const end = map.index(r.x + r.width - 1, y);
+    std::fill(map.iter.begin() + begin, map.iter.begin() + end, iter);
+    std::fill(map.mag.begin() + begin, map.mag.begin() + end, mag);
+    map.forget_orbits(begin, end);
+  }
+}
+
+/// Mariani-Silver step for a rectangle whose border is already computed.
+template <std::size_t MAX_ITER>
+auto subdivide_rect(viewport const &vp, iteration_map &map, rect r, fill_mode fill)
+    -> std::size_t {
+  if (r.width <= 2 or r.height <= 2) {
+    return 0; // border only, nothing inside
+  }
+  auto const fillable = fill == fill_mode::bands or map.iter[map.index(r.x, r.y)] >= MAX_ITER;
+  if (fillable and border_uniform(map, r)) {
+    fill_interior(map, r);
+    return 0;
+  }
+  if (r.width < SUBDIVIDE_MIN_SIZE or r.height < SUBDIVIDE_MIN_SIZE) {
+    return render_rect<MAX_ITER>(vp, map, {r.x + 1, r.y + 1, r.width - 2, r.height - 2});
+  }
+
+  // Compute the dividing row and column, which become shared borders of the four children
+  auto const xm = r.x + r.width / 2;
+  auto const ym = r.y + r.height / 2;
+  auto const bottom = r.y + r.height - 1;
+  compute_line<MAX_ITER>(vp, map, r.x + 1, ym, 1, 0, r.width - 2);
+  compute_line<MAX_ITER>(vp, map, xm, r.y + 1, 0, 1, ym - r.y - 1);
+  compute_line<MAX_ITER>(vp, map, xm, ym + 1, 0, 1, bottom - ym - 1);
+  auto computed = (r.width - 2) + (r.height - 3);
+
+  auto const left_w = xm - r.x + 1;
+  auto const right_w = r.x + r.width - xm;
+  auto const top_h = ym - r.y + 1;
+  auto const bottom_h = r.y + r.height - ym;
+  computed += subdivide_rect<MAX_ITER>(vp, map, {r.x, r.y, left_w, top_h}, fill);
+  computed += subdivide_rect<MAX_ITER>(vp, map, {xm, r.y, right_w, top_h}, fill);
+  computed += subdivide_rect<MAX_ITER>(vp, map, {r.x, ym, left_w, bottom_h}, fill);
+  computed += subdivide_rect<MAX_ITER>(vp, map, {xm, ym, right_w, bottom_h}, fill);
+  return computed;
+}
+
+} // namespace
+
+/// Mariani-Silver: evaluate rectangle borders only, fill uniform rectangles, split the rest.
+/// Tiles of `region` are processed in parallel, each reported to `on_tile` as render_brute_force
+/// does; returns the number of pixels actually iterated. `fill` limits which rectangles are
+/// filled.
+template <std::size_t MAX_ITER, typename OnTile = ignore_tile>
+auto render_subdivide(
+    viewport const &vp,
+    iteration_map &map,
+    auto scheduler,
+    rect region,
+    fill_mode fill = fill_mode::bands,
+    OnTile on_tile = {}
+) -> std::size_t {
+  auto const [tiles_x, tiles_y] = tile_count(region);
+  auto computed = std::atomic<std::size_t>{0};
+
+  parallel_for(scheduler, tiles_x * tiles_y, [&](std::size_t i) {
+    auto const r = tile_bounds(region, i % tiles_x, i / tiles_x);
+    auto const bottom = r.y + r.height - 1;
+    auto const right = r.x + r.width - 1;
+
+    compute_line<MAX_ITER>(vp, map, r.x, r.y, 1, 0, r.width);
+    auto count = r.width;
+    if (r.height > 1) {
+      compute_line<MAX_ITER>(vp, map, r.x, bottom, 1, 0, r.width);
+      compute_line<MAX_ITER>(vp, map, r.x, r.y + 1, 0, 1, r.height - 2);
+      count += r.width + (r.height - 2);
+      if (r.width > 1) {
+        compute_line<MAX_ITER>(vp, map, right, r.y + 1, 0, 1, r.height - 2);
+        count += r.height - 2;
+      }
+    }
+
+    count += subdivide_rect<MAX_ITER>(vp, map, r, fill);
+    computed.fetch_add(count, std::memory_order_relaxed);
+    on_tile(r);
+  });
+
+  return computed.load();
+}
+
+} // namespace mandelbrot::tile
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "mandelbrot/tile.hpp"
+
+namespace mandelbrot::tile {
+
+/// Sub-pixel offset in [0, 1)^2 of the k-th temporal sample: the R2 low-discrepancy sequence,
+/// starting at the pixel centre so sample 0 matches a plain render.
+[[nodiscard]] inline auto jitter(std::size_t k) -> std::pair<double, double> {
+  // 1/g and 1/g^2 for the plastic number g, the root of x^3 = x + 1
+  constexpr auto a1 = 0.7548776662466927;
+  constexpr auto a2 = 0.5698402909980532;
+  auto const frac = [](double v) { return v - static_cast<double>(static_cast<std::size_t>(v)); };
+  return {frac(0.5 + a1 * static_cast<double>(k)), frac(0.5 + a2 * static_cast<double>(k))};
+}
+
+/// `vp` moved so its pixel (px, py) samples the point at (px + ox, py + oy) of the original.
+[[nodiscard]] inline auto jittered(viewport vp, std::pair<double, double> offset) -> viewport {
+  auto const scale = vp.scale();
+  vp.center_x += (offset.first - 0.5) * scale;
+  vp.center_y -= (offset.second - 0.5) * scale;
+  return vp;
+}
+
+/// Running per-pixel mean of RGB frames. Pixels of a frame may be added concurrently; the
+/// frame is then closed with `finish_frame`.
+class accumulator {
+public:
+  using rgb = std::array<float, 3>;
+
+  void reset(std::size_t pixels) {
+    sum_.assign(pixels, rgb{});
+    frames_ = 0;
+  }
+
+  [[nodiscard]] auto frames() const -> std::size_t { return frames_; }
+
+  void add(std::size_t pixel, rgb const &colour) {
+    auto &sum = sum_[pixel];
+    for (std::size_t c = 0; c != 3; ++c) {
+      sum[c] += colour[c];
+    }
+  }
+  void finish_frame() { ++frames_; }
+
+  [[nodiscard]] auto mean(std::size_t pixel) const -> rgb {
+    auto const inv = 1.0f / static_cast<float>(frames_);
+    auto const &sum = sum_[pixel];
+    return {sum[0] * inv, sum[1] * inv, sum[2] * inv};
+  }
+
+private:
+  std::vector<rgb> sum_;
+  std::size_t frames_{};
+};
+
+} // namespace mandelbrot::tile
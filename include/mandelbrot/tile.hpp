@@ -0,0 +1,458 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <xsimd/xsimd.hpp>
+
+#include "mandelbrot/backend.hpp"
+
+namespace mandelbrot::tile {
+
+inline constexpr std::size_t TILE_SIZE = 64;
+inline constexpr double VIEWPORT_SCALE = 3.0;
+
+/// Maps pixel coordinates of a width x height frame onto the complex plane.
+struct viewport {
+  double center_x = -0.7;
+  double center_y = 0.0;
+  double zoom = 0.8;
+  std::size_t width = 800;
+  std::size_t height = 600;
+
+  [[nodiscard]] auto scale() const -> double {
+    return VIEWPORT_SCALE / (zoom * static_cast<double>(std::min(width, height)));
+  }
+  [[nodiscard]] auto real(double px) const -> double {
+    return center_x + (px - static_cast<double>(width) / 2.0) * scale();
+  }
+  [[nodiscard]] auto imag(double py) const -> double {
+    return center_y - (py - static_cast<double>(height) / 2.0) * scale();
+  }
+};
+
+struct rect {
+  std::size_t x{};
+  std::size_t y{};
+  std::size_t width{};
+  std::size_t height{};
+
+  [[nodiscard]] auto area() const -> std::size_t { return width * height; }
+};
+
+/// Pixels `r` of `vp` as a viewport of their own: its pixel (x, y) is pixel (r.x + x, r.y + y)
+/// of `vp`.
+[[nodiscard]] inline auto crop(viewport const &vp, rect const &r) -> viewport {
+  auto const w = static_cast<double>(r.width);
+  auto const h = static_cast<double>(r.height);
+  return {
+      vp.real(static_cast<double>(r.x) + w / 2.0),
+      vp.imag(static_cast<double>(r.y) + h / 2.0),
+      VIEWPORT_SCALE / (vp.scale() * std::min(w, h)),
+      r.width,
+      r.height
+  };
+}
+
+/// Moves the contents of a row-major width x height buffer by (dx, dy) pixels, so that the value
+/// at (x, y) ends up at (x + dx, y + dy). Exposed pixels keep stale values.
+template <typename T>
+void shift_pixels(
+    std::span<T> pixels,
+    std::size_t width,
+    std::size_t height,
+    std::ptrdiff_t dx,
+    std::ptrdiff_t dy
+) {
+  auto const w = static_cast<std::ptrdiff_t>(width);
+  auto const h = static_cast<std::ptrdiff_t>(height);
+  if ((dx == 0 and dy == 0) or std::abs(dx) >= w or std::abs(dy) >= h) {
+    return;
+  }
+  auto const columns = w - std::abs(dx);
+  auto const src_x = std::max<std::ptrdiff_t>(-dx, 0);
+  auto const dst_x = std::max<std::ptrdiff_t>(dx, 0);
+
+  // Walk rows against the direction of motion so no source row is overwritten before it is read
+  for (std::ptrdiff_t i = 0; i != h - std::abs(dy); ++i) {
+    auto const dst_y = dy > 0 ? h - 1 - i : i;
+    auto const src = pixels.begin() + (dst_y - dy) * w + src_x;
+    auto const dst = pixels.begin() + dst_y * w + dst_x;
+    if (dx > 0) {
+      std::copy_backward(src, src + columns, dst + columns);
+    } else {
+      std::copy(src, src + columns, dst);
+    }
+  }
+}
+
+/// orbit_x of a sample with no orbit kept.
+inline constexpr double NO_ORBIT = std::numeric_limits<double>::quiet_NaN();
+
+/// Per-pixel escape data: iteration count and |z|^2 at escape (for smooth colouring).
+///
+/// A map asked to keep_orbits() also holds the orbit point z = x + yi each iterated sample
+/// stopped at, so raising the limit can resume samples still inside rather than start them over.
+/// Whatever writes a sample other than by iterating it forgets its orbit.
+struct iteration_map {
+  std::size_t width{};
+  std::size_t height{};
+  std::vector<std::size_t> iter;
+  std::vector<double> mag;
+  std::vector<double> orbit_x; // NO_ORBIT where none is kept
+  std::vector<double> orbit_y;
+  bool orbits_kept{};
+
+  void resize(std::size_t w, std::size_t h) {
+    width = w;
+    height = h;
+    iter.resize(w * h);
+    mag.resize(w * h);
+    if (orbits_kept) {
+      orbit_x.resize(w * h, NO_ORBIT);
+      orbit_y.resize(w * h);
+    }
+  }
+  [[nodiscard]] auto index(std::size_t x, std::size_t y) const -> std::size_t {
+    return y * width + x;
+  }
+  void shift(std::ptrdiff_t dx, std::ptrdiff_t dy) {
+    shift_pixels(std::span(iter), width, height, dx, dy);
+    shift_pixels(std::span(mag), width, height, dx, dy);
+    if (orbits_kept) {
+      shift_pixels(std::span(orbit_x), width, height, dx, dy);
+      shift_pixels(std::span(orbit_y), width, height, dx, dy);
+    }
+  }
+
+  /// Starts or stops keeping orbits; once started, samples have them as they are iterated again.
+  void keep_orbits(bool keep) {
+    if (keep == orbits_kept) {
+      return;
+    }
+    orbits_kept = keep;
+    orbit_x = keep ? std::vector<double>(iter.size(), NO_ORBIT) : std::vector<double>{};
+    orbit_y = keep ? std::vector<double>(iter.size(), 0.0) : std::vector<double>{};
+  }
+  /// Records that sample i stopped at z = x + yi.
+  void keep_orbit(std::size_t i, double x, double y) {
+    if (orbits_kept) {
+      orbit_x[i] = x;
+      orbit_y[i] = y;
+    }
+  }
+  /// Samples [first, last) were written some other way than by iterating them.
+  void forget_orbits(std::size_t first, std::size_t last) {
+    if (orbits_kept) {
+      std::fill(orbit_x.begin() + first, orbit_x.begin() + last, NO_ORBIT);
+    }
+  }
+  [[nodiscard]] auto has_orbit(std::size_t i) const -> bool {
+    return orbits_kept and not std::isnan(orbit_x[i]);
+  }
+};
+
+[[nodiscard]] inline auto tile_count(rect const &r, std::size_t tile_size = TILE_SIZE)
+    -> std::pair<std::size_t, std::size_t> {
+  return {(r.width + tile_size - 1) / tile_size, (r.height + tile_size - 1) / tile_size};
+}
+
+[[nodiscard]] inline auto tile_count(viewport const &vp, std::size_t tile_size = TILE_SIZE)
+    -> std::pair<std::size_t, std::size_t> {
+  return tile_count(rect{0, 0, vp.width, vp.height}, tile_size);
+}
+
+/// Tile (tx, ty) of `r`, clipped to it.
+[[nodiscard]] inline auto tile_bounds(
+    rect const &r,
+    std::size_t tx,
+    std::size_t ty,
+    std::size_t tile_size = TILE_SIZE
+) -> rect {
+  auto const x = tx * tile_size;
+  auto const y = ty * tile_size;
+  return {r.x + x, r.y + y, std::min(tile_size, r.width - x), std::min(tile_size, r.height - y)};
+}
+
+[[nodiscard]] inline auto tile_bounds(
+    viewport const &vp,
+    std::size_t tx,
+    std::size_t ty,
+    std::size_t tile_size = TILE_SIZE
+) -> rect {
+  return tile_bounds(rect{0, 0, vp.width, vp.height}, tx, ty, tile_size);
+}
+
+/// Area uncovered when a width x height frame is shifted by (dx, dy): a band of whole rows plus
+/// a band of columns over the remaining rows. The whole frame if nothing can be reused.
+[[nodiscard]] inline auto exposed_strips(
+    std::size_t width,
+    std::size_t height,
+    std::ptrdiff_t dx,
+    std::ptrdiff_t dy
+) -> std::vector<rect> {
+  auto const ax = static_cast<std::size_t>(std::abs(dx));
+  auto const ay = static_cast<std::size_t>(std::abs(dy));
+  if (ax >= width or ay >= height) {
+    return {{0, 0, width, height}};
+  }
+  auto strips = std::vector<rect>{};
+  auto const kept_y = dy > 0 ? ay : 0;
+  if (ay != 0) {
+    strips.push_back({0, dy > 0 ? 0 : height - ay, width, ay});
+  }
+  if (ax != 0) {
+    strips.push_back({dx > 0 ? 0 : width - ax, kept_y, ax, height - ay});
+  }
+  return strips;
+}
+
+/// Resamples a width x height frame for a zoom about the continuous pixel position (cx, cy):
+/// pixel (x, y) takes the nearest source pixel under (cx, cy) + ((x, y) + 0.5 - (cx, cy)) * ratio,
+/// or `fill` where that lies outside the source. `ratio` is the old zoom over the new one.
+template <typename T>
+void resample_zoom(
+    std::span<T const> src,
+    std::span<T> dst,
+    std::size_t width,
+    std::size_t height,
+    double cx,
+    double cy,
+    double ratio,
+    T const &fill
+) {
+  auto const w = static_cast<double>(width);
+  auto const h = static_cast<double>(height);
+  auto columns = std::vector<std::ptrdiff_t>(width);
+  for (std::size_t x = 0; x != width; ++x) {
+    auto const sx = std::floor(cx + (static_cast<double>(x) + 0.5 - cx) * ratio);
+    columns[x] = sx >= 0.0 and sx < w ? static_cast<std::ptrdiff_t>(sx) : -1;
+  }
+  for (std::size_t y = 0; y != height; ++y) {
+    auto const sy = std::floor(cy + (static_cast<double>(y) + 0.5 - cy) * ratio);
+    auto const row = dst.begin() + static_cast<std::ptrdiff_t>(y * width);
+    if (sy < 0.0 or sy >= h) {
+      std::fill(row, row + static_cast<std::ptrdiff_t>(width), fill);
+      continue;
+    }
+    auto const src_row = src.begin() + static_cast<std::ptrdiff_t>(sy * w);
+    for (std::size_t x = 0; x != width; ++x) {
+      row[x] = columns[x] < 0 ? fill : src_row[columns[x]];
+    }
+  }
+}
+
+/// Pixels of a frame zoomed out by `ratio` (>= 1) about (cx, cy) whose whole footprint lies
+/// inside the previous frame; empty when zooming in.
+[[nodiscard]] inline auto zoom_covered(
+    std::size_t width,
+    std::size_t height,
+    double cx,
+    double cy,
+    double ratio
+) -> rect {
+  if (ratio < 1.0) {
+    return {};
+  }
+  constexpr auto slack = 1e-9;
+  auto const span = [&](double c, std::size_t extent) -> std::pair<std::size_t, std::size_t> {
+    auto const e = static_cast<double>(extent);
+    auto const lo = std::clamp(std::ceil(c - c / ratio - slack), 0.0, e);
+    auto const hi = std::clamp(std::floor(c + (e - c) / ratio + slack), lo, e);
+    return {static_cast<std::size_t>(lo), static_cast<std::size_t>(hi - lo)};
+  };
+  auto const [x, covered_w] = span(cx, width);
+  auto const [y, covered_h] = span(cy, height);
+  return {x, y, covered_w, covered_h};
+}
+
+namespace {
+
+template <typename T>
+auto iota_batch(T start) -> xsimd::batch<T> {
+  using batch_t = xsimd::batch<T>;
+  alignas(alignof(batch_t)) T tmp[batch_t::size];
+  for (std::size_t i = 0; i != batch_t::size; ++i) {
+    tmp[i] = start + static_cast<T>(i);
+  }
+  return batch_t::load_aligned(tmp);
+}
+
+/// Runs z -> z^2 + c, c = a + bi, on from z = x + yi after `start` iterations, up to MAX_ITER in
+/// all. Returns each lane's iteration count and |z|^2 at escape; (x, y) is left at the orbit
+/// point reached, which for lanes still inside is the state to resume from.
+template <std::size_t MAX_ITER>
+constexpr auto escape_from = [](xsimd::batch<double> a,
+                                xsimd::batch<double> b,
+                                std::size_t start,
+                                xsimd::batch<double> &x,
+                                xsimd::batch<double> &y)
+    -> std::pair<xsimd::batch<std::size_t>, xsimd::batch<double>> {
+  using batch = xsimd::batch<double>;
+  using bsize = xsimd::batch<std::size_t>;
+
+  auto const four = batch(4.0);
+  auto const two = batch(2.0);
+  auto const one = bsize(1);
+
+  auto iter = bsize(start);
+
+  auto x2 = x * x;
+  auto y2 = y * y;
+  auto mag = x2 + y2;
+
+#pragma clang loop unroll_count(16)
+  for (auto i = start; i < MAX_ITER; ++i) {
+    auto const mask = mag <= four;
+    if ((i - start) % 16 == 0 and none(mask)) {
+      break;
+    }
+
+    auto const xy = x * y;
+    auto const mask_i = batch_bool_cast<std::size_t>(mask);
+
+    x = x2 - y2 + a;
+    y = fma(two, xy, b);
+    x2 = x * x;
+    y2 = y * y;
+    // Only update where still running
+    iter = select(mask_i, iter + one, iter);
+    mag = select(mask, x2 + y2, mag);
+  }
+
+  return {iter, mag};
+};
+
+template <std::size_t MAX_ITER>
+constexpr auto escape_simd =
+    [](xsimd::batch<double> a,
+       xsimd::batch<double> b) -> std::pair<xsimd::batch<std::size_t>, xsimd::batch<double>> {
+  auto x = xsimd::batch<double>(0.0);
+  auto y = xsimd::batch<double>(0.0);
+  return escape_from<MAX_ITER>(a, b, 0, x, y);
+};
+
+} // namespace
+
+/// Evaluates `count` pixels starting at (x, y) and stepping by (dx, dy).
+template <std::size_t MAX_ITER>
+void compute_line(
+    viewport const &vp,
+    iteration_map &map,
+    std::size_t x,
+    std::size_t y,
+    std::size_t dx,
+    std::size_t dy,
+    std::size_t count
+) {
+  using batch = xsimd::batch<double>;
+  using bsize = xsimd::batch<std::size_t>;
+  constexpr auto lanes = batch::size;
+
+  auto const scale = vp.scale();
+  auto const re0 = batch(vp.real(static_cast<double>(x) + 0.5));
+  auto const im0 = batch(vp.imag(static_cast<double>(y) + 0.5));
+  auto const re_step = batch(static_cast<double>(dx) * scale);
+  auto const im_step = batch(-static_cast<double>(dy) * scale);
+
+  alignas(alignof(bsize)) std::size_t iters[lanes];
+  alignas(alignof(batch)) double mags[lanes];
+  alignas(alignof(batch)) double xs[lanes];
+  alignas(alignof(batch)) double ys[lanes];
+  for (std::size_t i = 0; i < count; i += lanes) {
+    auto const t = xsimd::batch_cast<double>(iota_batch(i));
+    auto zx = batch(0.0);
+    auto zy = batch(0.0);
+    auto const [iter, mag] =
+        escape_from<MAX_ITER>(re0 + t * re_step, im0 + t * im_step, 0, zx, zy);
+    iter.store_aligned(iters);
+    mag.store_aligned(mags);
+    zx.store_aligned(xs);
+    zy.store_aligned(ys);
+
+    auto const valid = std::min(lanes, count - i);
+    for (std::size_t lane = 0; lane != valid; ++lane) {
+      auto const idx = map.index(x + (i + lane) * dx, y + (i + lane) * dy);
+      map.iter[idx] = iters[lane];
+      map.mag[idx] = mags[lane];
+      map.keep_orbit(idx, xs[lane], ys[lane]);
+    }
+  }
+}
+
+/// Evaluates an arbitrary set of pixels, given as indices into `map`.
+template <std::size_t MAX_ITER>
+void compute_points(viewport const &vp, iteration_map &map, std::span<std::size_t const> points) {
+  using batch = xsimd::batch<double>;
+  using bsize = xsimd::batch<std::size_t>;
+  constexpr auto lanes = batch::size;
+
+  alignas(alignof(batch)) double re[lanes];
+  alignas(alignof(batch)) double im[lanes];
+  alignas(alignof(bsize)) std::size_t iters[lanes];
+  alignas(alignof(batch)) double mags[lanes];
+  for (std::size_t i = 0; i < points.size(); i += lanes) {
+    auto const valid = std::min(lanes, points.size() - i);
+    for (std::size_t lane = 0; lane != lanes; ++lane) {
+      auto const p = points[i + std::min(lane, valid - 1)];
+      re[lane] = vp.real(static_cast<double>(p % map.width) + 0.5);
+      im[lane] = vp.imag(static_cast<double>(p / map.width) + 0.5);
+    }
+    auto zx = batch(0.0);
+    auto zy = batch(0.0);
+    auto const [iter, mag] =
+        escape_from<MAX_ITER>(batch::load_aligned(re), batch::load_aligned(im), 0, zx, zy);
+    iter.store_aligned(iters);
+    mag.store_aligned(mags);
+    // The coordinates are spent; reuse their buffers for the orbit points
+    zx.store_aligned(re);
+    zy.store_aligned(im);
+    for (std::size_t lane = 0; lane != valid; ++lane) {
+      map.iter[points[i + lane]] = iters[lane];
+      map.mag[points[i + lane]] = mags[lane];
+      map.keep_orbit(points[i + lane], re[lane], im[lane]);
+    }
+  }
+}
+
+/// Evaluates every pixel of `r`; returns the number of pixels computed.
+template <std::size_t MAX_ITER>
+auto render_rect(viewport const &vp, iteration_map &map, rect r) -> std::size_t {
+  for (std::size_t y = r.y; y != r.y + r.height; ++y) {
+    compute_line<MAX_ITER>(vp, map, r.x, y, 1, 0, r.width);
+  }
+  return r.area();
+}
+
+/// Which areas the shortcut strategies may fill instead of iterating: any area bounded by one
+/// escape count, or only areas inside the set. Smooth colouring reads |z|^2, which varies across
+/// a band of equal counts, so a filled band comes out flat; it needs `interior`.
+enum class fill_mode : int { bands = 0, interior };
+
+/// The renderers' default `on_tile`, for callers that only want the finished map.
+struct ignore_tile {
+  void operator()(rect) const {}
+};
+
+/// Brute force: every pixel of `region`, one tile per work item. `on_tile(r)` is called on the
+/// worker as soon as the pixels of r are final, concurrently from several workers.
+template <std::size_t MAX_ITER, typename OnTile = ignore_tile>
+auto render_brute_force(
+    viewport const &vp, iteration_map &map, auto scheduler, rect region, OnTile on_tile = {}
+) -> std::size_t {
+  auto const [tiles_x, tiles_y] = tile_count(region);
+  parallel_for(scheduler, tiles_x * tiles_y, [&](std::size_t i) {
+    auto const r = tile_bounds(region, i % tiles_x, i / tiles_x);
+    render_rect<MAX_ITER>(vp, map, r);
+    on_tile(r);
+  });
+  return region.area();
+}
+
+} // namespace mandelbrot::tile
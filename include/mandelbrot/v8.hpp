@@ -1,8 +1,9 @@
 #pragma once
 
-#include <stdexec/execution.hpp>
 #include <xsimd/xsimd.hpp>
 
+#include "mandelbrot/backend.hpp"
+
 namespace mandelbrot::v8 {
 
 namespace {
@@ -68,16 +69,14 @@ void mandelbrot(auto &vec, auto &&gen, auto scheduler) {
   constexpr bool is_scalar =
       std::is_same_v<typename std::decay_t<decltype(vec)>::value_type, std::size_t>;
 
-  auto sender =
-      stdexec::bulk(stdexec::schedule(scheduler), stdexec::par, vec.size(), [&](std::size_t i) {
-        if constexpr (is_scalar) {
-          vec[i] = mandelbrot_scalar<MAX_ITER>(gen(i));
-        } else {
-          vec[i] = std::apply(mandelbrot_simd<MAX_ITER>, gen(i));
-        }
-      });
-
-  stdexec::sync_wait(std::move(sender));
+  // `scheduler` is a stdexec scheduler or a mandelbrot::backend_scheduler
+  mandelbrot::parallel_for(scheduler, vec.size(), [&](std::size_t i) {
+    if constexpr (is_scalar) {
+      vec[i] = mandelbrot_scalar<MAX_ITER>(gen(i));
+    } else {
+      vec[i] = std::apply(mandelbrot_simd<MAX_ITER>, gen(i));
+    }
+  });
 }
 
 } // namespace mandelbrot::v8
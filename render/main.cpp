@@ -0,0 +1,957 @@
+// Headless renderer: same tile, SIMD and palette pipeline as the viewer, written to PPM/PNG/QOI.
+
+#include <mandelbrot/backend.hpp>
+#include <mandelbrot/checkpoint.hpp>
+#include <mandelbrot/colour.hpp>
+#include <mandelbrot/expmap.hpp>
+#include <mandelbrot/image.hpp>
+#include <mandelbrot/iterfile.hpp>
+#include <mandelbrot/png.hpp>
+#include <mandelbrot/qoi.hpp>
+#include <mandelbrot/queue.hpp>
+#include <mandelbrot/render.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// MAX_ITER is a template parameter throughout, so only these limits are compiled in.
+constexpr std::size_t SUPPORTED_ITERATIONS[] = {
+    100, 250, 500, 1000, 2500, 5000, 10'000, 25'000, 50'000, 100'000
+};
+
+struct options {
+  double center_x = -0.7;
+  double center_y = 0.0;
+  double zoom = 0.8;
+  std::size_t width = 1920;
+  std::size_t height = 1080;
+  std::size_t iterations = 1000;
+  mandelbrot::colour::scheme scheme = mandelbrot::colour::scheme::classic;
+  bool smooth = true;
+  std::size_t samples_per_side = 1;
+  std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+  mandelbrot::backend backend = mandelbrot::backend::stdexec;
+  mandelbrot::tile::strategy strategy = mandelbrot::tile::strategy::brute_force;
+  std::filesystem::path output = "mandelbrot.png";
+  std::size_t frames = 0; // Non-zero: zoom video to stdout instead of a single image
+  double zoom_to = 0.0;
+  bool exp_map = false;
+  bool poster = false;
+  double checkpoint_seconds = 30.0;
+  std::filesystem::path pyramid;  // Non-empty: tile pyramid into this directory
+  std::filesystem::path recolour; // Non-empty: colour this iteration file instead of rendering
+};
+
+constexpr std::string_view USAGE = R"(usage: mandelbrot_render [options]
+  --center X,Y       centre of the view (default -0.7,0)
+  --zoom Z           zoom factor (default 0.8)
+  --size WxH         image size in pixels (default 1920x1080)
+  --iterations N     iteration limit, one of 100, 250, 500, 1000, 2500,
+                     5000, 10000, 25000, 50000, 100000 (default 1000)
+  --scheme NAME|N    colour scheme by name or number (default classic)
+  --no-smooth        band colouring instead of smooth colouring
+  --aa N             N x N samples per pixel, 1-4 (default 1)
+  --threads N        worker threads (default: all cores)
+  --backend NAME     stdexec, tbb, libdispatch or openmp (default stdexec)
+  --strategy NAME    brute, subdivide or boundary (default brute)
+  -o, --output FILE  .ppm, .png or .qoi (default mandelbrot.png), or .mbi to save the smooth
+                     iteration counts for recolouring instead
+  --poster           render in bands streamed to a .ppm or .mbi, for images larger than memory;
+                     rerunning an interrupted poster resumes it
+  --checkpoint S     seconds between poster checkpoints (default 30)
+  --pyramid DIR      write a zoomable pyramid of 256 px tiles as DIR/{z}/{x}/{y}.png,
+                     --size being the deepest level; reruns of the same job skip
+                     existing tiles, and DIR/job.txt keeps other jobs out
+  --recolour FILE    colour a saved .mbi smoothly with --scheme instead of rendering; the
+                     view, size, samples and iteration limit come from the file
+
+zoom video:
+  --frames N         render N frames zooming exponentially from --zoom to --zoom-to
+                     about --center, written to stdout as raw RGB24, e.g.
+                     | ffmpeg -f rawvideo -pix_fmt rgb24 -s WxH -r 60 -i - zoom.mp4
+  --zoom-to Z        zoom factor of the last frame
+  --exp-map          render one log-polar strip for the whole zoom and reproject every
+                     frame from it; far less iteration work, slightly softer frames
+)";
+
+template <typename T>
+[[nodiscard]] auto parse_number(std::string_view text) -> std::optional<T> {
+  auto value = T{};
+  auto const [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+  if (ec != std::errc{} or end != text.data() + text.size()) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+template <typename T>
+[[nodiscard]] auto parse_pair(std::string_view text, char separator)
+    -> std::optional<std::pair<T, T>> {
+  auto const split = text.find(separator);
+  if (split == std::string_view::npos) {
+    return std::nullopt;
+  }
+  auto const first = parse_number<T>(text.substr(0, split));
+  auto const second = parse_number<T>(text.substr(split + 1));
+  if (not first or not second) {
+    return std::nullopt;
+  }
+  return std::pair{*first, *second};
+}
+
+/// Lower-cased letters and digits only, so "Hot Iron", "hot-iron" and "hotiron" all match.
+[[nodiscard]] auto simplify(std::string_view name) -> std::string {
+  auto out = std::string{};
+  for (auto const c : name) {
+    if ((c >= 'a' and c <= 'z') or (c >= '0' and c <= '9')) {
+      out += c;
+    } else if (c >= 'A' and c <= 'Z') {
+      out += static_cast<char>(c - 'A' + 'a');
+    }
+  }
+  return out;
+}
+
+/// Matches the name of any enum value `E(0)` .. `E(count - 1)`, or its number.
+template <typename E>
+[[nodiscard]] auto parse_enum(std::string_view text, auto &&names_of) -> std::optional<E> {
+  auto const count = static_cast<int>(E::count);
+  if (auto const index = parse_number<int>(text); index and *index >= 0 and *index < count) {
+    return static_cast<E>(*index);
+  }
+  auto const wanted = simplify(text);
+  for (auto i = 0; i != count; ++i) {
+    for (auto const name : names_of(static_cast<E>(i))) {
+      if (simplify(name) == wanted) {
+        return static_cast<E>(i);
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+[[nodiscard]] auto parse_options(int argc, char **argv) -> std::optional<options> {
+  auto opts = options{};
+  for (auto i = 1; i < argc; ++i) {
+    auto const arg = std::string_view(argv[i]);
+    if (arg == "-h" or arg == "--help") {
+      return std::nullopt;
+    }
+    if (arg == "--no-smooth") {
+      opts.smooth = false;
+      continue;
+    }
+    if (arg == "--exp-map") {
+      opts.exp_map = true;
+      continue;
+    }
+    if (arg == "--poster") {
+      opts.poster = true;
+      continue;
+    }
+    if (i + 1 == argc) {
+      std::cerr << std::format("missing value for {}", arg) << '\n';
+      return std::nullopt;
+    }
+    auto const value = std::string_view(argv[++i]);
+    auto ok = true;
+    if (arg == "--center") {
+      auto const c = parse_pair<double>(value, ',');
+      ok = c.has_value();
+      if (ok) {
+        std::tie(opts.center_x, opts.center_y) = *c;
+      }
+    } else if (arg == "--zoom") {
+      auto const z = parse_number<double>(value);
+      ok = z and *z > 0.0;
+      opts.zoom = z.value_or(0.0);
+    } else if (arg == "--size") {
+      auto const s = parse_pair<std::size_t>(value, 'x');
+      ok = s and s->first > 0 and s->second > 0;
+      if (ok) {
+        std::tie(opts.width, opts.height) = *s;
+      }
+    } else if (arg == "--iterations") {
+      auto const n = parse_number<std::size_t>(value);
+      ok = n and std::ranges::find(SUPPORTED_ITERATIONS, *n) != std::end(SUPPORTED_ITERATIONS);
+      opts.iterations = n.value_or(0);
+    } else if (arg == "--scheme") {
+      auto const s = parse_enum<mandelbrot::colour::scheme>(value, [](auto s) {
+        auto const name = mandelbrot::colour::to_string(s);
+        // "classic" is what everyone calls the Ultra Fractal scheme
+        return std::array{name, s == mandelbrot::colour::scheme::classic ? "classic" : name};
+      });
+      ok = s.has_value();
+      opts.scheme = s.value_or(opts.scheme);
+    } else if (arg == "--aa") {
+      auto const n = parse_number<std::size_t>(value);
+      ok = n and *n >= 1 and *n <= 4;
+      opts.samples_per_side = n.value_or(1);
+    } else if (arg == "--threads") {
+      auto const n = parse_number<std::size_t>(value);
+      ok = n and *n > 0;
+      opts.threads = n.value_or(1);
+    } else if (arg == "--backend") {
+      auto const b = parse_enum<mandelbrot::backend>(value, [](auto b) {
+        return std::array{mandelbrot::to_string(b)};
+      });
+      ok = b and mandelbrot::available(*b);
+      opts.backend = b.value_or(opts.backend);
+    } else if (arg == "--strategy") {
+      auto const s = parse_enum<mandelbrot::tile::strategy>(value, [](auto s) {
+        constexpr std::string_view short_names[] = {"brute", "subdivide", "boundary"};
+        return std::array{mandelbrot::tile::to_string(s), short_names[static_cast<int>(s)]};
+      });
+      ok = s.has_value();
+      opts.strategy = s.value_or(opts.strategy);
+    } else if (arg == "--frames") {
+      auto const n = parse_number<std::size_t>(value);
+      ok = n and *n > 0;
+      opts.frames = n.value_or(0);
+    } else if (arg == "--zoom-to") {
+      auto const z = parse_number<double>(value);
+      ok = z and *z > 0.0;
+      opts.zoom_to = z.value_or(0.0);
+    } else if (arg == "--checkpoint") {
+      auto const s = parse_number<double>(value);
+      ok = s and *s > 0.0;
+      opts.checkpoint_seconds = s.value_or(0.0);
+    } else if (arg == "--pyramid") {
+      opts.pyramid = value;
+      ok = not opts.pyramid.empty();
+    } else if (arg == "--recolour") {
+      opts.recolour = value;
+      ok = not opts.recolour.empty();
+    } else if (arg == "-o" or arg == "--output") {
+      opts.output = value;
+      auto const ext = opts.output.extension();
+      ok = ext == ".ppm" or ext == ".png" or ext == ".qoi" or ext == ".mbi";
+    } else {
+      std::cerr << std::format("unknown option {}", arg) << '\n';
+      return std::nullopt;
+    }
+    if (not ok) {
+      std::cerr << std::format("invalid value for {}: {}", arg, value) << '\n';
+      return std::nullopt;
+    }
+  }
+  if (opts.frames != 0 and opts.zoom_to == 0.0) {
+    std::cerr << "--frames needs --zoom-to\n";
+    return std::nullopt;
+  }
+  auto const ext = opts.output.extension();
+  if (opts.poster and (opts.frames != 0 or (ext != ".ppm" and ext != ".mbi"))) {
+    std::cerr << "--poster writes a single .ppm or .mbi\n";
+    return std::nullopt;
+  }
+  if (ext == ".mbi" and (opts.frames != 0 or not opts.pyramid.empty())) {
+    std::cerr << ".mbi output is for single images and posters\n";
+    return std::nullopt;
+  }
+  if (not opts.recolour.empty() and
+      (opts.frames != 0 or opts.poster or not opts.pyramid.empty() or ext == ".mbi")) {
+    std::cerr << "--recolour writes a single .ppm, .png or .qoi\n";
+    return std::nullopt;
+  }
+  if (not opts.recolour.empty() and not opts.smooth) {
+    std::cerr << "--recolour only colours smoothly: a .mbi holds smooth, not escape, counts\n";
+    return std::nullopt;
+  }
+  if (not opts.pyramid.empty() and (opts.frames != 0 or opts.poster)) {
+    std::cerr << "--pyramid cannot be combined with --frames or --poster\n";
+    return std::nullopt;
+  }
+  if (opts.exp_map and opts.frames == 0) {
+    std::cerr << "--exp-map needs --frames\n";
+    return std::nullopt;
+  }
+  return opts;
+}
+
+/// Calls f.template operator()<N>() with N = iterations, which must be a supported limit.
+auto with_max_iter(std::size_t iterations, auto &&f) -> int {
+  return [&]<std::size_t... I>(std::index_sequence<I...>) {
+    auto result = 1;
+    static_cast<void>(
+        ((iterations == SUPPORTED_ITERATIONS[I]
+              ? (result = f.template operator()<SUPPORTED_ITERATIONS[I]>(), true)
+              : false) or
+         ...)
+    );
+    return result;
+  }(std::make_index_sequence<std::size(SUPPORTED_ITERATIONS)>{});
+}
+
+using clock = std::chrono::steady_clock;
+using seconds = std::chrono::duration<double>;
+
+[[nodiscard]] auto saves_samples(options const &opts) -> bool {
+  return opts.output.extension() == ".mbi";
+}
+
+/// Renders `vp` with n x n samples per pixel into `map`; returns the iterations spent. Pixels a
+/// strategy fills without iterating still count, so for those this is an upper bound.
+template <std::size_t MAX_ITER>
+auto render_samples(
+    options const &opts,
+    mandelbrot::tile::viewport const &vp,
+    mandelbrot::backend_pool &pool,
+    mandelbrot::tile::iteration_map &map
+) -> double {
+  auto const n = opts.samples_per_side;
+  auto const fine = mandelbrot::tile::viewport{
+      vp.center_x, vp.center_y, vp.zoom, vp.width * n, vp.height * n
+  };
+  // Saved samples may be recoloured smoothly later
+  auto const fill = opts.smooth or saves_samples(opts) ? mandelbrot::tile::fill_mode::interior
+                                                       : mandelbrot::tile::fill_mode::bands;
+  mandelbrot::tile::render<MAX_ITER>(
+      fine, map, pool.get_scheduler(opts.backend), opts.strategy, fill
+  );
+  return std::accumulate(map.iter.begin(), map.iter.end(), 0.0);
+}
+
+/// render_samples, then colours `map` into `image`.
+template <std::size_t MAX_ITER>
+auto render_frame(
+    options const &opts,
+    mandelbrot::tile::viewport const &vp,
+    mandelbrot::colour::palette const &palette,
+    mandelbrot::backend_pool &pool,
+    mandelbrot::tile::iteration_map &map,
+    mandelbrot::rgb_image &image
+) -> double {
+  auto const iterations = render_samples<MAX_ITER>(opts, vp, pool, map);
+  mandelbrot::colour::shade<MAX_ITER>(
+      map,
+      opts.samples_per_side,
+      palette,
+      opts.smooth,
+      pool.get_scheduler(opts.backend),
+      pool.available_parallelism(),
+      image
+  );
+  return iterations;
+}
+
+template <std::size_t MAX_ITER>
+[[nodiscard]] auto iteration_header(options const &opts) -> mandelbrot::iteration_file_header {
+  auto header = mandelbrot::iteration_file_header{};
+  header.center_x = opts.center_x;
+  header.center_y = opts.center_y;
+  header.zoom = opts.zoom;
+  header.max_iter = MAX_ITER;
+  header.width = static_cast<std::uint32_t>(opts.width);
+  header.height = static_cast<std::uint32_t>(opts.height);
+  header.samples_per_side = static_cast<std::uint32_t>(opts.samples_per_side);
+  header.tile_size = static_cast<std::uint32_t>(mandelbrot::tile::TILE_SIZE);
+  return header;
+}
+
+/// Writes an image to `path` by its extension: .png, .qoi or .ppm.
+void write_image(
+    std::filesystem::path const &path,
+    mandelbrot::rgb_image const &image,
+    mandelbrot::backend_pool &pool,
+    mandelbrot::backend backend
+) {
+  auto const scheduler = pool.get_scheduler(backend);
+  if (path.extension() == ".png") {
+    mandelbrot::write_png(path, image, scheduler);
+  } else if (path.extension() == ".qoi") {
+    mandelbrot::write_qoi(path, image, scheduler);
+  } else {
+    mandelbrot::write_ppm(path, image);
+  }
+}
+
+template <std::size_t MAX_ITER>
+auto render_image(options const &opts) -> int {
+  auto pool = mandelbrot::backend_pool(opts.threads);
+  auto const palette = mandelbrot::colour::palette::build<MAX_ITER>(opts.scheme);
+  auto const vp = mandelbrot::tile::viewport{
+      opts.center_x, opts.center_y, opts.zoom, opts.width, opts.height
+  };
+
+  auto const start = clock::now();
+  auto map = mandelbrot::tile::iteration_map{};
+  auto image = mandelbrot::rgb_image{};
+  auto const iterations = saves_samples(opts)
+                              ? render_samples<MAX_ITER>(opts, vp, pool, map)
+                              : render_frame<MAX_ITER>(opts, vp, palette, pool, map, image);
+  auto const rendered = clock::now();
+
+  if (saves_samples(opts)) {
+    auto writer = mandelbrot::iteration_file_writer(opts.output, iteration_header<MAX_ITER>(opts));
+    writer.write(map);
+    writer.finish();
+  } else {
+    write_image(opts.output, image, pool, opts.backend);
+  }
+  auto const written = clock::now();
+
+  auto const render_seconds = seconds(rendered - start).count();
+  std::cerr << std::format(
+      "{}x{} ({}x{} AA, {} iterations, {}, {} threads): render {:.1f} ms, {:.3f} Giter/s, "
+      "write {:.1f} ms",
+      opts.width,
+      opts.height,
+      opts.samples_per_side,
+      opts.samples_per_side,
+      MAX_ITER,
+      mandelbrot::to_string(opts.backend),
+      pool.available_parallelism(),
+      render_seconds * 1e3,
+      iterations / render_seconds * 1e-9,
+      seconds(written - rendered).count() * 1e3
+  ) << '\n';
+  return 0;
+}
+
+/// Everything a job's pixels depend on, to tell a resumed job from a different one.
+template <std::size_t MAX_ITER>
+[[nodiscard]] auto job_description(options const &opts) -> std::string {
+  return std::format(
+      "{} {} {} {}x{} {} {} {} {} {}",
+      opts.center_x,
+      opts.center_y,
+      opts.zoom,
+      opts.width,
+      opts.height,
+      MAX_ITER,
+      opts.samples_per_side,
+      static_cast<int>(opts.scheme),
+      opts.smooth,
+      static_cast<int>(opts.strategy)
+  );
+}
+
+/// Rows per poster band.
+constexpr std::size_t POSTER_BAND_ROWS = mandelbrot::tile::TILE_SIZE;
+
+/// Poster bands held at once: all but one render while the oldest is written.
+constexpr std::size_t POSTER_BANDS_IN_FLIGHT = 3;
+
+/// Renders the image in bands of POSTER_BAND_ROWS rows, written in order to a PPM (or an
+/// iteration file, a tile row per band) by this thread while the next bands render, so memory
+/// stays at POSTER_BANDS_IN_FLIGHT bands whatever the image size. Finished bands are recorded in
+/// a checkpoint beside the output, so rerunning an interrupted job renders only what is missing.
+template <std::size_t MAX_ITER>
+auto render_poster(options const &opts) -> int {
+  struct band_slot {
+    mandelbrot::tile::iteration_map map;
+    mandelbrot::rgb_image image;
+    std::vector<float> counts;
+    double iterations{};
+  };
+
+  auto pool = mandelbrot::backend_pool(opts.threads);
+  auto const palette = mandelbrot::colour::palette::build<MAX_ITER>(opts.scheme);
+  auto const vp = mandelbrot::tile::viewport{
+      opts.center_x, opts.center_y, opts.zoom, opts.width, opts.height
+  };
+  auto const bands = (opts.height + POSTER_BAND_ROWS - 1) / POSTER_BAND_ROWS;
+
+  // Both formats are a header and then fixed-size bands
+  auto const samples = saves_samples(opts);
+  auto const counts_header = iteration_header<MAX_ITER>(opts);
+  auto const header =
+      samples ? std::string(reinterpret_cast<char const *>(&counts_header), sizeof(counts_header))
+              : mandelbrot::ppm_header(opts.width, opts.height);
+  auto const band_bytes =
+      samples ? counts_header.tile_row_bytes() : POSTER_BAND_ROWS * opts.width * 3;
+  auto const size =
+      samples ? counts_header.file_size() : header.size() + opts.width * opts.height * 3;
+
+  auto checkpoint_path = opts.output;
+  checkpoint_path += ".checkpoint";
+  auto error = std::error_code{};
+  if (std::filesystem::file_size(opts.output, error) != size) {
+    std::filesystem::remove(checkpoint_path); // Stale: its output is gone
+  }
+  auto const job = job_description<MAX_ITER>(opts) + ' ' + opts.output.extension().string();
+  auto output = std::optional<mandelbrot::positioned_file>{};
+  auto progress = mandelbrot::checkpoint(
+      checkpoint_path,
+      mandelbrot::fingerprint(job),
+      bands,
+      seconds(opts.checkpoint_seconds),
+      [&] { output->sync(); }
+  );
+  auto const resumed = progress.done_count();
+  output.emplace(opts.output, size, resumed != 0);
+  output->write_at(0, std::as_bytes(std::span(header)));
+  auto todo = std::vector<std::size_t>{};
+  for (std::size_t band = 0; band != bands; ++band) {
+    if (not progress.done(band)) {
+      todo.push_back(band);
+    }
+  }
+  auto total = 0.0;
+
+  auto const start = clock::now();
+  mandelbrot::ordered_pipeline<band_slot>(
+      todo.size(),
+      POSTER_BANDS_IN_FLIGHT,
+      [&](std::size_t i, band_slot &slot) {
+        auto const y = todo[i] * POSTER_BAND_ROWS;
+        auto const rows = std::min(POSTER_BAND_ROWS, opts.height - y);
+        auto const band_vp = mandelbrot::tile::crop(vp, {0, y, opts.width, rows});
+        if (samples) {
+          slot.iterations = render_samples<MAX_ITER>(opts, band_vp, pool, slot.map);
+          mandelbrot::encode_tile_row(counts_header, slot.map, 0, slot.counts);
+        } else {
+          slot.iterations =
+              render_frame<MAX_ITER>(opts, band_vp, palette, pool, slot.map, slot.image);
+        }
+      },
+      [&](std::size_t i, band_slot &slot) {
+        auto const bytes = samples ? std::as_bytes(std::span(slot.counts))
+                                   : std::as_bytes(std::span(slot.image.pixels));
+        output->write_at(header.size() + todo[i] * band_bytes, bytes);
+        progress.mark(todo[i]);
+        total += slot.iterations;
+      }
+  );
+  output->sync();
+  progress.complete();
+
+  auto const elapsed = seconds(clock::now() - start).count();
+  auto const saves = progress.statistics();
+  std::cerr << std::format(
+      "{}x{} poster in {} bands, {} already done ({}x{} AA, {} iterations, {}, {} threads): "
+      "{:.2f} s, {:.3f} Giter/s; {} checkpoints, {:.1f} ms in total, {:.1f} ms longest",
+      opts.width,
+      opts.height,
+      bands,
+      resumed,
+      opts.samples_per_side,
+      opts.samples_per_side,
+      MAX_ITER,
+      mandelbrot::to_string(opts.backend),
+      pool.available_parallelism(),
+      elapsed,
+      total / elapsed * 1e-9,
+      saves.saves,
+      saves.total_seconds * 1e3,
+      saves.max_seconds * 1e3
+  ) << '\n';
+  return 0;
+}
+
+/// Side of a pyramid tile in pixels, as web map clients expect.
+constexpr std::size_t PYRAMID_TILE = 256;
+
+/// Pyramid tiles made at once, each on its own thread.
+constexpr std::size_t PYRAMID_TILES_IN_FLIGHT = 4;
+
+[[nodiscard]] auto pyramid_tile_path(
+    std::filesystem::path const &dir,
+    std::size_t z,
+    std::size_t x,
+    std::size_t y
+) -> std::filesystem::path {
+  return dir / std::to_string(z) / std::to_string(x) / (std::to_string(y) + ".png");
+}
+
+/// Writes through a temporary file and a rename, so an interrupted run never leaves a partial
+/// file at `path`.
+void write_file(std::filesystem::path const &path, std::span<std::uint8_t const> bytes) {
+  std::filesystem::create_directories(path.parent_path());
+  auto tmp = path;
+  tmp += ".tmp";
+  {
+    auto out = std::ofstream(tmp, std::ios::binary);
+    out.write(reinterpret_cast<char const *>(bytes.data()), std::ssize(bytes));
+    if (not out) {
+      throw std::runtime_error("cannot write " + tmp.string());
+    }
+  }
+  std::filesystem::rename(tmp, path);
+}
+
+/// Grows `image` to `width` x `height`, keeping its pixels at the top left and filling the rest
+/// with black.
+void pad_black(mandelbrot::rgb_image &image, std::size_t width, std::size_t height) {
+  auto const old_row = image.width * 3;
+  auto const row = width * 3;
+  auto const old_height = image.height;
+  image.pixels.resize(row * height);
+  auto *const pixels = image.pixels.data();
+  // Rows only move further on, so the last moves first
+  for (auto y = old_height; y-- != 0;) {
+    auto const *const source = pixels + y * old_row;
+    std::copy_backward(source, source + old_row, pixels + y * row + old_row);
+    std::fill(pixels + y * row + old_row, pixels + (y + 1) * row, std::uint8_t{0});
+  }
+  std::fill(pixels + old_height * row, pixels + height * row, std::uint8_t{0});
+  image.width = width;
+  image.height = height;
+}
+
+/// Names the job whose tiles a pyramid directory holds.
+constexpr std::string_view PYRAMID_JOB_FILE = "job.txt";
+
+/// Claims `dir` for `job`: a new or empty directory gets a job file, one with the same job file
+/// is resumed, and anything else is refused rather than mixed with this job's tiles.
+void claim_pyramid(std::filesystem::path const &dir, std::string const &job) {
+  auto const path = dir / PYRAMID_JOB_FILE;
+  if (auto in = std::ifstream(path, std::ios::binary)) {
+    auto const found = std::string(std::istreambuf_iterator<char>(in), {});
+    if (found != job) {
+      throw std::runtime_error(std::format(
+          "{} holds tiles of another job ({}); use another directory or remove it",
+          dir.string(),
+          found
+      ));
+    }
+    return;
+  }
+  if (std::filesystem::exists(dir) and not std::filesystem::is_empty(dir)) {
+    throw std::runtime_error(std::format(
+        "{} is not empty and has no {}; use an empty directory", dir.string(), PYRAMID_JOB_FILE
+    ));
+  }
+  write_file(path, {reinterpret_cast<std::uint8_t const *>(job.data()), job.size()});
+}
+
+/// XYZ tile pyramid: level `deepest` tiles the --size image at PYRAMID_TILE pixels and is the
+/// only one rendered; each coarser level is its children box-filtered 2:1, read back from disk.
+/// Tiles already on disk are skipped, so an interrupted run of the same job resumes where it
+/// stopped; claim_pyramid keeps other jobs out of the directory.
+template <std::size_t MAX_ITER>
+auto render_pyramid(options const &opts) -> int {
+  struct tile_slot {
+    mandelbrot::tile::iteration_map map;
+    mandelbrot::rgb_image image;
+    std::vector<std::uint8_t> png;
+    double iterations{};
+  };
+  using tile_xy = std::pair<std::size_t, std::size_t>;
+
+  claim_pyramid(opts.pyramid, job_description<MAX_ITER>(opts));
+  auto pool = mandelbrot::backend_pool(opts.threads);
+  auto const palette = mandelbrot::colour::palette::build<MAX_ITER>(opts.scheme);
+  auto const vp = mandelbrot::tile::viewport{
+      opts.center_x, opts.center_y, opts.zoom, opts.width, opts.height
+  };
+
+  // Tiles per side at each level, coarsest (a single tile) first
+  auto grid = std::vector<tile_xy>{
+      {(opts.width + PYRAMID_TILE - 1) / PYRAMID_TILE,
+       (opts.height + PYRAMID_TILE - 1) / PYRAMID_TILE}
+  };
+  while (grid.back() != tile_xy{1, 1}) {
+    grid.push_back({(grid.back().first + 1) / 2, (grid.back().second + 1) / 2});
+  }
+  std::ranges::reverse(grid);
+  auto const deepest = grid.size() - 1;
+
+  auto const start = clock::now();
+  auto made = std::size_t{};
+  auto skipped = std::size_t{};
+  auto total = 0.0;
+  for (auto z = deepest + 1; z-- != 0;) {
+    auto todo = std::vector<tile_xy>{};
+    for (std::size_t y = 0; y != grid[z].second; ++y) {
+      for (std::size_t x = 0; x != grid[z].first; ++x) {
+        if (std::filesystem::exists(pyramid_tile_path(opts.pyramid, z, x, y))) {
+          ++skipped;
+        } else {
+          todo.emplace_back(x, y);
+        }
+      }
+    }
+
+    mandelbrot::ordered_pipeline<tile_slot>(
+        todo.size(),
+        PYRAMID_TILES_IN_FLIGHT,
+        [&](std::size_t i, tile_slot &slot) {
+          auto const [x, y] = todo[i];
+          slot.iterations = 0.0;
+          if (z == deepest) {
+            // Edge tiles render only what lies inside --size and are padded black like the
+            // coarser levels
+            auto const r = mandelbrot::tile::rect{
+                x * PYRAMID_TILE,
+                y * PYRAMID_TILE,
+                std::min(PYRAMID_TILE, opts.width - x * PYRAMID_TILE),
+                std::min(PYRAMID_TILE, opts.height - y * PYRAMID_TILE)
+            };
+            slot.iterations = render_frame<MAX_ITER>(
+                opts, mandelbrot::tile::crop(vp, r), palette, pool, slot.map, slot.image
+            );
+            pad_black(slot.image, PYRAMID_TILE, PYRAMID_TILE);
+          } else {
+            // Children beyond the edge of the finer level stay black
+            slot.image.resize(PYRAMID_TILE, PYRAMID_TILE);
+            std::ranges::fill(slot.image.pixels, std::uint8_t{0});
+            for (std::size_t child = 0; child != 4; ++child) {
+              auto const cx = 2 * x + child % 2;
+              auto const cy = 2 * y + child / 2;
+              if (cx < grid[z + 1].first and cy < grid[z + 1].second) {
+                mandelbrot::downsample_into(
+                    mandelbrot::read_png(pyramid_tile_path(opts.pyramid, z + 1, cx, cy)),
+                    slot.image,
+                    child % 2 * PYRAMID_TILE / 2,
+                    child / 2 * PYRAMID_TILE / 2
+                );
+              }
+            }
+          }
+          slot.png = mandelbrot::encode_png(slot.image);
+        },
+        [&](std::size_t i, tile_slot &slot) {
+          write_file(pyramid_tile_path(opts.pyramid, z, todo[i].first, todo[i].second), slot.png);
+          total += slot.iterations;
+          ++made;
+        }
+    );
+  }
+
+  auto const elapsed = seconds(clock::now() - start).count();
+  std::cerr << std::format(
+      "{} levels of {} px tiles ({}x{} AA, {} iterations, {}, {} threads): {} tiles made, {} "
+      "already present, {:.2f} s, {:.3f} Giter/s",
+      grid.size(),
+      PYRAMID_TILE,
+      opts.samples_per_side,
+      opts.samples_per_side,
+      MAX_ITER,
+      mandelbrot::to_string(opts.backend),
+      pool.available_parallelism(),
+      made,
+      skipped,
+      elapsed,
+      total / elapsed * 1e-9
+  ) << '\n';
+  return 0;
+}
+
+/// Zoom of frame `frame` of a video: geometric steps from opts.zoom to opts.zoom_to.
+[[nodiscard]] auto zoom_at(options const &opts, std::size_t frame) -> double {
+  if (opts.frames == 1) {
+    return opts.zoom;
+  }
+  auto const t = static_cast<double>(frame) / static_cast<double>(opts.frames - 1);
+  return opts.zoom * std::pow(opts.zoom_to / opts.zoom, t);
+}
+
+void write_frame(mandelbrot::rgb_image const &image) {
+  if (std::fwrite(image.pixels.data(), 1, image.pixels.size(), stdout) != image.pixels.size()) {
+    throw std::runtime_error("cannot write frame to stdout");
+  }
+}
+
+/// Frames rendered at once by a zoom video. Each has its own renderer thread, so the tiles of the
+/// next frame are already queued on the pool while the last tiles of the current one finish.
+/// Each frame's slot is reused only after the frame has been written.
+constexpr std::size_t FRAMES_IN_FLIGHT = 2;
+
+/// Renders the zoom path frame by frame to stdout, keeping FRAMES_IN_FLIGHT frames in memory
+/// however far the encoder falls behind.
+template <std::size_t MAX_ITER>
+auto render_video(options const &opts) -> int {
+  struct frame_slot {
+    mandelbrot::tile::iteration_map map;
+    mandelbrot::rgb_image image;
+    double iterations{};
+  };
+
+  auto pool = mandelbrot::backend_pool(opts.threads);
+  auto const palette = mandelbrot::colour::palette::build<MAX_ITER>(opts.scheme);
+  auto total = 0.0;
+
+  auto const start = clock::now();
+  mandelbrot::ordered_pipeline<frame_slot>(
+      opts.frames,
+      FRAMES_IN_FLIGHT,
+      [&](std::size_t frame, frame_slot &slot) {
+        auto const vp = mandelbrot::tile::viewport{
+            opts.center_x, opts.center_y, zoom_at(opts, frame), opts.width, opts.height
+        };
+        slot.iterations = render_frame<MAX_ITER>(opts, vp, palette, pool, slot.map, slot.image);
+      },
+      [&](std::size_t, frame_slot &slot) {
+        write_frame(slot.image);
+        total += slot.iterations;
+      }
+  );
+  std::fflush(stdout);
+
+  auto const elapsed = seconds(clock::now() - start).count();
+  std::cerr << std::format(
+      "{} frames of {}x{} ({}x{} AA, {} iterations, {}, {} threads): {:.2f} s, {:.2f} frames/s, "
+      "{:.3f} Giter/s",
+      opts.frames,
+      opts.width,
+      opts.height,
+      opts.samples_per_side,
+      opts.samples_per_side,
+      MAX_ITER,
+      mandelbrot::to_string(opts.backend),
+      pool.available_parallelism(),
+      elapsed,
+      static_cast<double>(opts.frames) / elapsed,
+      total / elapsed * 1e-9
+  ) << '\n';
+  return 0;
+}
+
+/// Renders the zoom path as one exp_map strip, then reprojects every frame from it.
+template <std::size_t MAX_ITER>
+auto render_exp_video(options const &opts) -> int {
+  auto pool = mandelbrot::backend_pool(opts.threads);
+  auto const scheduler = pool.get_scheduler(opts.backend);
+  auto const workers = pool.available_parallelism();
+  auto const palette = mandelbrot::colour::palette::build<MAX_ITER>(opts.scheme);
+  auto const first = mandelbrot::tile::viewport{
+      opts.center_x, opts.center_y, opts.zoom, opts.width, opts.height
+  };
+  auto const em = mandelbrot::tile::exp_map_for(first, opts.zoom_to, opts.samples_per_side);
+
+  auto const start = clock::now();
+  auto strip = mandelbrot::rgb_image{};
+  auto const iterations = mandelbrot::render_exp_strip<MAX_ITER>(
+      em, palette, opts.smooth, scheduler, workers, strip
+  );
+  auto const rendered = clock::now();
+
+  auto const reprojector = mandelbrot::exp_reprojector(em, first, opts.samples_per_side);
+  auto image = mandelbrot::rgb_image{};
+  for (std::size_t frame = 0; frame != opts.frames; ++frame) {
+    reprojector.frame(strip, zoom_at(opts, frame), scheduler, workers, image);
+    write_frame(image);
+  }
+  std::fflush(stdout);
+  auto const written = clock::now();
+
+  auto const render_seconds = seconds(rendered - start).count();
+  auto const frame_seconds = seconds(written - rendered).count();
+  std::cerr << std::format(
+      "{} frames of {}x{} from a {}x{} exp map ({} iterations, {}, {} threads): strip {:.2f} s, "
+      "{:.3f} Giter/s; frames {:.2f} s, {:.2f} frames/s",
+      opts.frames,
+      opts.width,
+      opts.height,
+      em.width,
+      em.height,
+      MAX_ITER,
+      mandelbrot::to_string(opts.backend),
+      workers,
+      render_seconds,
+      iterations / render_seconds * 1e-9,
+      frame_seconds,
+      static_cast<double>(opts.frames) / frame_seconds
+  ) << '\n';
+  return 0;
+}
+
+/// Colours a saved iteration file a tile row at a time, streamed straight out for PPM so that
+/// posters recolour in constant memory, or gathered into one image for PNG and QOI.
+template <std::size_t MAX_ITER>
+auto recolour(options const &opts, mandelbrot::iteration_file const &file) -> int {
+  auto pool = mandelbrot::backend_pool(opts.threads);
+  auto const palette = mandelbrot::colour::palette::build<MAX_ITER>(opts.scheme);
+  auto const &header = file.header();
+  auto writer = std::optional<mandelbrot::ppm_writer>{};
+  auto image = mandelbrot::rgb_image{};
+  if (opts.output.extension() == ".ppm") {
+    writer.emplace(opts.output, header.width, header.height);
+  } else {
+    image.resize(header.width, header.height);
+  }
+
+  auto const start = clock::now();
+  auto band = mandelbrot::rgb_image{};
+  for (std::size_t ty = 0; ty != header.tiles_y(); ++ty) {
+    mandelbrot::colour::recolour<MAX_ITER>(
+        file, ty, palette, pool.get_scheduler(opts.backend), band
+    );
+    if (writer) {
+      writer->write(band);
+    } else {
+      auto const offset = ty * header.tile_size * image.width * 3;
+      std::ranges::copy(band.pixels, image.pixels.begin() + static_cast<std::ptrdiff_t>(offset));
+    }
+  }
+  if (writer) {
+    writer->finish();
+  } else {
+    write_image(opts.output, image, pool, opts.backend);
+  }
+
+  std::cerr << std::format(
+      "{}x{} ({}x{} AA, {} iterations) recoloured with {} in {:.1f} ms",
+      header.width,
+      header.height,
+      header.samples_per_side,
+      header.samples_per_side,
+      MAX_ITER,
+      mandelbrot::colour::to_string(opts.scheme),
+      seconds(clock::now() - start).count() * 1e3
+  ) << '\n';
+  return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  auto const opts = parse_options(argc, argv);
+  if (not opts) {
+    std::cerr << USAGE;
+    return 2;
+  }
+  try {
+    if (not opts->recolour.empty()) {
+      auto const file = mandelbrot::iteration_file(opts->recolour);
+      auto const limit = file.header().max_iter;
+      if (std::ranges::find(SUPPORTED_ITERATIONS, limit) == std::end(SUPPORTED_ITERATIONS)) {
+        throw std::runtime_error(std::format("unsupported iteration limit {}", limit));
+      }
+      return with_max_iter(limit, [&]<std::size_t MAX_ITER>() {
+        return recolour<MAX_ITER>(*opts, file);
+      });
+    }
+    return with_max_iter(opts->iterations, [&]<std::size_t MAX_ITER>() {
+      if (opts->exp_map) {
+        return render_exp_video<MAX_ITER>(*opts);
+      }
+      if (opts->poster) {
+        return render_poster<MAX_ITER>(*opts);
+      }
+      if (not opts->pyramid.empty()) {
+        return render_pyramid<MAX_ITER>(*opts);
+      }
+      return opts->frames != 0 ? render_video<MAX_ITER>(*opts) : render_image<MAX_ITER>(*opts);
+    });
+  } catch (std::exception const &e) {
+    std::cerr << std::format("mandelbrot_render: {}", e.what()) << '\n';
+    return 1;
+  }
+}
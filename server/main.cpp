@@ -0,0 +1,610 @@
+// Localhost HTTP/1.1 tile server: /{z}/{x}/{y}.png from the tile renderer, with coalescing of
+// concurrent requests for the same tile and visible tiles ahead of prefetches.
+
+#include <mandelbrot/backend.hpp>
+#include <mandelbrot/cache.hpp>
+#include <mandelbrot/colour.hpp>
+#include <mandelbrot/image.hpp>
+#include <mandelbrot/png.hpp>
+#include <mandelbrot/render.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <format>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using mandelbrot::tile::tile_data;
+using mandelbrot::tile::tile_key;
+
+/// MAX_ITER is a template parameter throughout, so only these limits are compiled in.
+constexpr std::size_t SUPPORTED_ITERATIONS[] = {
+    100, 250, 500, 1000, 2500, 5000, 10'000, 25'000, 50'000, 100'000
+};
+
+/// Side of a served tile in pixels.
+constexpr std::size_t WEB_TILE = 256;
+
+/// The z = 0 tile: a WEB_WORLD_SPAN square about (WEB_WORLD_X, 0) holding the whole set.
+constexpr double WEB_WORLD_X = -0.5;
+constexpr double WEB_WORLD_SPAN = 4.0;
+
+/// Deepest zoom level served; beyond it doubles run out of precision.
+constexpr int MAX_WEB_LEVEL = 44;
+
+/// Threads taking tiles off the queues; each tile itself renders across the pool.
+constexpr std::size_t RENDER_WORKERS = 2;
+
+/// Requests whose latency feeds the percentiles on /stats.
+constexpr std::size_t LATENCY_WINDOW = 4096;
+
+constexpr std::size_t MAX_REQUEST_BYTES = 8192;
+
+struct options {
+  std::uint16_t port = 8080;
+  std::size_t iterations = 1000;
+  std::size_t samples_per_side = 1;
+  std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+  std::size_t cache_mb = 512;
+};
+
+constexpr std::string_view USAGE = R"(usage: mandelbrot_tile_server [options]
+  --port N           TCP port on 127.0.0.1 (default 8080)
+  --iterations N     iteration limit, one of 100, 250, 500, 1000, 2500,
+                     5000, 10000, 25000, 50000, 100000 (default 1000)
+  --aa N             N x N samples per pixel, 1-4 (default 1)
+  --threads N        worker threads (default: all cores)
+  --cache-mb N       memory for cached tiles (default 512)
+
+GET /{z}/{x}/{y}.png[?scheme=N][&prefetch=1]   tile; prefetches wait behind visible tiles
+GET /stats                                     queue depth, cache and latency as JSON
+)";
+
+[[noreturn]] void throw_errno(char const *what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+template <typename T>
+[[nodiscard]] auto parse_number(std::string_view text) -> std::optional<T> {
+  auto value = T{};
+  auto const [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+  if (ec != std::errc{} or end != text.data() + text.size()) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+[[nodiscard]] auto parse_options(int argc, char **argv) -> std::optional<options> {
+  auto opts = options{};
+  for (auto i = 1; i < argc; ++i) {
+    auto const arg = std::string_view(argv[i]);
+    if (arg == "-h" or arg == "--help" or i + 1 == argc) {
+      return std::nullopt;
+    }
+    auto const value = std::string_view(argv[++i]);
+    auto ok = true;
+    if (arg == "--port") {
+      auto const n = parse_number<std::uint16_t>(value);
+      ok = n and *n != 0;
+      opts.port = n.value_or(0);
+    } else if (arg == "--iterations") {
+      auto const n = parse_number<std::size_t>(value);
+      ok = n and std::ranges::find(SUPPORTED_ITERATIONS, *n) != std::end(SUPPORTED_ITERATIONS);
+      opts.iterations = n.value_or(0);
+    } else if (arg == "--aa") {
+      auto const n = parse_number<std::size_t>(value);
+      ok = n and *n >= 1 and *n <= 4;
+      opts.samples_per_side = n.value_or(1);
+    } else if (arg == "--threads") {
+      auto const n = parse_number<std::size_t>(value);
+      ok = n and *n > 0;
+      opts.threads = n.value_or(1);
+    } else if (arg == "--cache-mb") {
+      auto const n = parse_number<std::size_t>(value);
+      ok = n.has_value();
+      opts.cache_mb = n.value_or(0);
+    } else {
+      std::cerr << std::format("unknown option {}", arg) << '\n';
+      return std::nullopt;
+    }
+    if (not ok) {
+      std::cerr << std::format("invalid value for {}: {}", arg, value) << '\n';
+      return std::nullopt;
+    }
+  }
+  return opts;
+}
+
+/// Viewport of web tile (z, x, y), y growing downwards.
+[[nodiscard]] auto web_tile_viewport(tile_key const &key) -> mandelbrot::tile::viewport {
+  auto const span = std::ldexp(WEB_WORLD_SPAN, -key.level);
+  auto const side = WEB_TILE * key.samples_per_side;
+  return {
+      WEB_WORLD_X - WEB_WORLD_SPAN / 2.0 + (static_cast<double>(key.x) + 0.5) * span,
+      WEB_WORLD_SPAN / 2.0 - (static_cast<double>(key.y) + 0.5) * span,
+      mandelbrot::tile::VIEWPORT_SCALE / span,
+      side,
+      side
+  };
+}
+
+/// Latencies of the last LATENCY_WINDOW requests.
+class latency_window {
+public:
+  void record(double ms) {
+    auto const lock = std::lock_guard{mutex_};
+    samples_[next_++ % LATENCY_WINDOW] = ms;
+  }
+
+  /// The given percentiles (0-100), in milliseconds; zero before any request.
+  [[nodiscard]] auto percentiles(std::span<double const> ps) const -> std::vector<double> {
+    auto sorted = std::vector<double>{};
+    {
+      auto const lock = std::lock_guard{mutex_};
+      sorted.assign(samples_.begin(), samples_.begin() + std::min(next_, LATENCY_WINDOW));
+    }
+    std::ranges::sort(sorted);
+    auto out = std::vector<double>{};
+    for (auto const p : ps) {
+      auto const rank = static_cast<std::size_t>(p / 100.0 * static_cast<double>(sorted.size()));
+      out.push_back(sorted.empty() ? 0.0 : sorted[std::min(rank, sorted.size() - 1)]);
+    }
+    return out;
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::array<double, LATENCY_WINDOW> samples_{};
+  std::size_t next_{};
+};
+
+/// Renders web tiles on demand behind a tile_cache. A tile requested while already queued or
+/// rendering joins that computation instead of starting another; visible tiles are taken before
+/// prefetches, and a prefetch still queued when it becomes visible moves up.
+template <std::size_t MAX_ITER>
+class tile_service {
+public:
+  explicit tile_service(options const &opts)
+      : pool_(opts.threads), cache_(opts.cache_mb << 20),
+        samples_per_side_(opts.samples_per_side) {
+    for (std::size_t i = 0; i != RENDER_WORKERS; ++i) {
+      workers_.emplace_back([this] { work(); });
+    }
+  }
+
+  ~tile_service() {
+    {
+      auto const lock = std::lock_guard{mutex_};
+      stopping_ = true;
+    }
+    work_ready_.notify_all();
+  }
+
+  /// Iteration data of tile (z, x, y); blocks until it is available.
+  [[nodiscard]] auto get(int z, std::int64_t x, std::int64_t y, bool prefetch) -> tile_data {
+    auto const key = tile_key{z, x, y, MAX_ITER, 0, static_cast<std::uint32_t>(samples_per_side_)};
+    if (auto data = cache_.find(key)) {
+      cache_hits_.fetch_add(1, std::memory_order_relaxed);
+      return data;
+    }
+    auto result = std::shared_future<tile_data>{};
+    {
+      auto const lock = std::lock_guard{mutex_};
+      auto const [it, inserted] = pending_.try_emplace(key);
+      auto &p = it->second;
+      if (inserted) {
+        // Finished between the lookup above and taking the lock; peek, as the miss is counted
+        if (auto data = cache_.peek(key)) {
+          pending_.erase(it);
+          cache_hits_.fetch_add(1, std::memory_order_relaxed);
+          return data;
+        }
+        ++cache_misses_;
+        p.result = p.promise.get_future().share();
+        p.prefetch = prefetch;
+        (prefetch ? prefetch_queue_ : visible_queue_).push_back(key);
+        ++(prefetch ? queued_prefetch_ : queued_visible_);
+        work_ready_.notify_one();
+      } else {
+        ++coalesced_;
+        if (not prefetch and p.prefetch and not p.started) {
+          p.prefetch = false;
+          --queued_prefetch_;
+          ++queued_visible_;
+          visible_queue_.push_back(key);
+        }
+      }
+      result = p.result;
+    }
+    return result.get();
+  }
+
+  /// Colours and encodes a tile with the given scheme.
+  [[nodiscard]] auto png(tile_data const &data, std::size_t scheme) -> std::vector<std::uint8_t> {
+    auto image = mandelbrot::rgb_image{};
+    mandelbrot::colour::shade<MAX_ITER>(
+        *data,
+        samples_per_side_,
+        palettes_[scheme],
+        true,
+        pool_.get_scheduler(),
+        pool_.available_parallelism(),
+        image
+    );
+    return mandelbrot::encode_png(image);
+  }
+
+  [[nodiscard]] auto stats_json() const -> std::string {
+    auto const lock = std::lock_guard{mutex_};
+    return std::format(
+        R"({{"queued":{{"visible":{},"prefetch":{}}},"rendering":{},"rendered":{},)"
+        R"("coalesced":{},"cache":{{"hit_rate":{:.4f},"bytes":{}}},)",
+        queued_visible_,
+        queued_prefetch_,
+        rendering_,
+        rendered_,
+        coalesced_,
+        hit_rate(),
+        cache_.size_bytes()
+    );
+  }
+
+private:
+  /// Share of requests answered from the cache among those that either were or had to queue a
+  /// render; requests that joined a render in flight are counted as coalesced instead.
+  [[nodiscard]] auto hit_rate() const -> double {
+    auto const hits = cache_hits_.load(std::memory_order_relaxed);
+    auto const requests = hits + cache_misses_;
+    return requests == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(requests);
+  }
+
+  struct pending_tile {
+    std::promise<tile_data> promise;
+    std::shared_future<tile_data> result;
+    bool prefetch = false;
+    bool started = false;
+  };
+
+  void work() {
+    while (true) {
+      auto key = tile_key{};
+      {
+        auto lock = std::unique_lock{mutex_};
+        work_ready_.wait(lock, [&] {
+          return stopping_ or not visible_queue_.empty() or not prefetch_queue_.empty();
+        });
+        if (stopping_) {
+          return;
+        }
+        auto &queue = visible_queue_.empty() ? prefetch_queue_ : visible_queue_;
+        key = queue.front();
+        queue.pop_front();
+        // A prefetch promoted to visible is queued twice; the later copy finds it started
+        auto const it = pending_.find(key);
+        if (it == pending_.end() or it->second.started) {
+          continue;
+        }
+        it->second.started = true;
+        --(it->second.prefetch ? queued_prefetch_ : queued_visible_);
+        ++rendering_;
+      }
+
+      auto data = tile_data{};
+      auto failure = std::exception_ptr{};
+      try {
+        auto map = std::make_shared<mandelbrot::tile::iteration_map>();
+        mandelbrot::tile::render<MAX_ITER>(web_tile_viewport(key), *map, pool_.get_scheduler());
+        data = std::move(map);
+        cache_.insert(key, data);
+      } catch (...) {
+        failure = std::current_exception();
+      }
+
+      auto const lock = std::lock_guard{mutex_};
+      auto const it = pending_.find(key);
+      if (failure) {
+        it->second.promise.set_exception(failure);
+      } else {
+        it->second.promise.set_value(data);
+      }
+      pending_.erase(it);
+      --rendering_;
+      ++rendered_;
+    }
+  }
+
+  mandelbrot::backend_pool pool_;
+  mandelbrot::tile::tile_cache cache_;
+  std::size_t samples_per_side_;
+  std::array<mandelbrot::colour::palette, mandelbrot::colour::SCHEME_COUNT> palettes_ =
+      mandelbrot::colour::build_palettes<MAX_ITER>();
+
+  mutable std::mutex mutex_;
+  std::condition_variable work_ready_;
+  std::unordered_map<tile_key, pending_tile, mandelbrot::tile::tile_key_hash> pending_;
+  std::deque<tile_key> visible_queue_;
+  std::deque<tile_key> prefetch_queue_;
+  std::size_t queued_visible_{};
+  std::size_t queued_prefetch_{};
+  std::size_t rendering_{};
+  std::size_t rendered_{};
+  std::size_t coalesced_{};
+  std::atomic<std::size_t> cache_hits_{0};
+  std::size_t cache_misses_{}; // Requests that queued a render
+  bool stopping_ = false;
+  std::vector<std::jthread> workers_;
+};
+
+void send_all(int fd, std::string_view head, std::span<std::uint8_t const> body) {
+  auto const send_bytes = [&](char const *data, std::size_t size) {
+    while (size != 0) {
+      auto const sent = ::send(fd, data, size, MSG_NOSIGNAL);
+      if (sent < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throw_errno("send");
+      }
+      data += sent;
+      size -= static_cast<std::size_t>(sent);
+    }
+  };
+  send_bytes(head.data(), head.size());
+  send_bytes(reinterpret_cast<char const *>(body.data()), body.size());
+}
+
+void respond(
+    int fd,
+    int status,
+    std::string_view reason,
+    std::string_view type,
+    std::span<std::uint8_t const> body,
+    bool keep_alive
+) {
+  auto const head = std::format(
+      "HTTP/1.1 {} {}\r\nContent-Type: {}\r\nContent-Length: {}\r\nConnection: {}\r\n\r\n",
+      status,
+      reason,
+      type,
+      body.size(),
+      keep_alive ? "keep-alive" : "close"
+  );
+  send_all(fd, head, body);
+}
+
+[[nodiscard]] auto as_bytes(std::string_view text) -> std::span<std::uint8_t const> {
+  return {reinterpret_cast<std::uint8_t const *>(text.data()), text.size()};
+}
+
+void respond_text(int fd, int status, std::string_view reason, std::string_view text, bool keep) {
+  respond(fd, status, reason, "text/plain", as_bytes(text), keep);
+}
+
+/// Value of `name` in a query string such as "a=1&b=2".
+[[nodiscard]] auto query_value(std::string_view query, std::string_view name)
+    -> std::optional<std::string_view> {
+  while (not query.empty()) {
+    auto const end = std::min(query.find('&'), query.size());
+    auto const pair = query.substr(0, end);
+    if (auto const eq = pair.find('='); pair.substr(0, eq) == name) {
+      return eq == std::string_view::npos ? std::string_view{} : pair.substr(eq + 1);
+    }
+    query.remove_prefix(std::min(end + 1, query.size()));
+  }
+  return std::nullopt;
+}
+
+/// Parses "/{z}/{x}/{y}.png" with x and y inside level z.
+[[nodiscard]] auto parse_tile_path(std::string_view path)
+    -> std::optional<std::tuple<int, std::int64_t, std::int64_t>> {
+  if (not path.starts_with('/') or not path.ends_with(".png")) {
+    return std::nullopt;
+  }
+  path = path.substr(1, path.size() - 5);
+  auto const first = path.find('/');
+  auto const second = path.find('/', first + 1);
+  if (first == std::string_view::npos or second == std::string_view::npos) {
+    return std::nullopt;
+  }
+  auto const z = parse_number<int>(path.substr(0, first));
+  auto const x = parse_number<std::int64_t>(path.substr(first + 1, second - first - 1));
+  auto const y = parse_number<std::int64_t>(path.substr(second + 1));
+  if (not z or not x or not y or *z < 0 or *z > MAX_WEB_LEVEL) {
+    return std::nullopt;
+  }
+  auto const tiles = std::int64_t{1} << *z;
+  if (*x < 0 or *y < 0 or *x >= tiles or *y >= tiles) {
+    return std::nullopt;
+  }
+  return std::tuple{*z, *x, *y};
+}
+
+/// Answers requests on one connection until the client closes it or asks to.
+template <std::size_t MAX_ITER>
+void serve_connection(int fd, tile_service<MAX_ITER> &service, latency_window &latency) {
+  auto buffer = std::string{};
+  auto chunk = std::array<char, 4096>{};
+  while (true) {
+    auto header_end = buffer.find("\r\n\r\n");
+    while (header_end == std::string::npos) {
+      if (buffer.size() > MAX_REQUEST_BYTES) {
+        respond_text(fd, 431, "Request Header Fields Too Large", "", false);
+        return;
+      }
+      auto const received = ::recv(fd, chunk.data(), chunk.size(), 0);
+      if (received < 0 and errno == EINTR) {
+        continue;
+      }
+      if (received <= 0) {
+        return;
+      }
+      buffer.append(chunk.data(), static_cast<std::size_t>(received));
+      header_end = buffer.find("\r\n\r\n");
+    }
+    auto const start = std::chrono::steady_clock::now();
+    auto const request = std::string_view(buffer).substr(0, header_end);
+    auto const line = request.substr(0, request.find("\r\n"));
+    auto const keep_alive = line.ends_with("HTTP/1.1") and
+                            request.find("Connection: close") == std::string_view::npos;
+
+    auto const method_end = line.find(' ');
+    auto const target_end = line.find(' ', method_end + 1);
+    if (method_end == std::string_view::npos or target_end == std::string_view::npos) {
+      respond_text(fd, 400, "Bad Request", "bad request line\n", false);
+      return;
+    }
+    auto const target = line.substr(method_end + 1, target_end - method_end - 1);
+    auto const query_start = std::min(target.find('?'), target.size());
+    auto const path = target.substr(0, query_start);
+    auto const query = target.substr(std::min(query_start + 1, target.size()));
+
+    if (line.substr(0, method_end) != "GET") {
+      respond_text(fd, 405, "Method Not Allowed", "only GET is supported\n", keep_alive);
+    } else if (path == "/stats") {
+      static constexpr double ps[] = {50.0, 90.0, 99.0, 100.0};
+      auto const p = latency.percentiles(ps);
+      auto const json = service.stats_json() +
+                        std::format(
+                            R"("latency_ms":{{"p50":{:.2f},"p90":{:.2f},"p99":{:.2f},)"
+                            R"("max":{:.2f}}}}})"
+                            "\n",
+                            p[0],
+                            p[1],
+                            p[2],
+                            p[3]
+                        );
+      respond(fd, 200, "OK", "application/json", as_bytes(json), keep_alive);
+    } else if (auto const tile = parse_tile_path(path)) {
+      auto const scheme = parse_number<std::size_t>(query_value(query, "scheme").value_or("0"));
+      if (not scheme or *scheme >= mandelbrot::colour::SCHEME_COUNT) {
+        respond_text(fd, 400, "Bad Request", "unknown scheme\n", keep_alive);
+      } else {
+        auto const prefetch = query_value(query, "prefetch").value_or("0") != "0";
+        auto const [z, x, y] = *tile;
+        auto const png = service.png(service.get(z, x, y, prefetch), *scheme);
+        respond(fd, 200, "OK", "image/png", png, keep_alive);
+        latency.record(
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+                .count()
+        );
+      }
+    } else {
+      respond_text(fd, 404, "Not Found", "not found\n", keep_alive);
+    }
+
+    if (not keep_alive) {
+      return;
+    }
+    buffer.erase(0, header_end + 4);
+  }
+}
+
+template <std::size_t MAX_ITER>
+auto serve(options const &opts) -> int {
+  auto const listener = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (listener < 0) {
+    throw_errno("socket");
+  }
+  auto const reuse = 1;
+  ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof reuse);
+  auto address = sockaddr_in{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(opts.port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (::bind(listener, reinterpret_cast<sockaddr const *>(&address), sizeof address) != 0) {
+    throw_errno("bind");
+  }
+  if (::listen(listener, SOMAXCONN) != 0) {
+    throw_errno("listen");
+  }
+
+  auto service = tile_service<MAX_ITER>(opts);
+  auto latency = latency_window{};
+  std::cerr << std::format(
+      "Serving http://127.0.0.1:{}/{{z}}/{{x}}/{{y}}.png ({} iterations, {}x{} AA, {} threads)",
+      opts.port,
+      MAX_ITER,
+      opts.samples_per_side,
+      opts.samples_per_side,
+      opts.threads
+  ) << '\n';
+
+  while (true) {
+    auto const fd = ::accept(listener, nullptr, nullptr);
+    if (fd < 0) {
+      if (errno == EINTR or errno == ECONNABORTED) {
+        continue;
+      }
+      throw_errno("accept");
+    }
+    std::thread([fd, &service, &latency] {
+      try {
+        serve_connection(fd, service, latency);
+      } catch (std::exception const &e) {
+        std::cerr << std::format("connection: {}", e.what()) << '\n';
+      }
+      ::close(fd);
+    }).detach();
+  }
+}
+
+/// Calls f.template operator()<N>() with N = iterations, which must be a supported limit.
+auto with_max_iter(std::size_t iterations, auto &&f) -> int {
+  return [&]<std::size_t... I>(std::index_sequence<I...>) {
+    auto result = 1;
+    static_cast<void>(
+        ((iterations == SUPPORTED_ITERATIONS[I]
+              ? (result = f.template operator()<SUPPORTED_ITERATIONS[I]>(), true)
+              : false) or
+         ...)
+    );
+    return result;
+  }(std::make_index_sequence<std::size(SUPPORTED_ITERATIONS)>{});
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  auto const opts = parse_options(argc, argv);
+  if (not opts) {
+    std::cerr << USAGE;
+    return 2;
+  }
+  try {
+    return with_max_iter(opts->iterations, [&]<std::size_t MAX_ITER>() {
+      return serve<MAX_ITER>(*opts);
+    });
+  } catch (std::exception const &e) {
+    std::cerr << std::format("mandelbrot_tile_server: {}", e.what()) << '\n';
+    return 1;
+  }
+}
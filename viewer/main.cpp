@@ -3,14 +3,41 @@
 #include <array>
 #include <chrono>
 #include <cmath>
-#include <exec/static_thread_pool.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <mandelbrot/adaptive.hpp>
+#include <mandelbrot/backend.hpp>
+#include <mandelbrot/balance.hpp>
+#include <mandelbrot/cache.hpp>
+#include <mandelbrot/colour.hpp>
+#include <mandelbrot/deepen.hpp>
+#include <mandelbrot/governor.hpp>
+#include <mandelbrot/image.hpp>
+#include <mandelbrot/limit.hpp>
+#include <mandelbrot/queue.hpp>
+#include <mandelbrot/render.hpp>
+#include <mandelbrot/store.hpp>
+#include <mandelbrot/temporal.hpp>
+#include <numeric>
+#include <span>
 #include <sstream>
 #include <string_view>
 #include <vector>
 #include <xsimd/xsimd.hpp>
 
 using batch_d = xsimd::batch<double>;
-inline constexpr std::size_t MAX_ITER = 1000;
+inline constexpr std::size_t MAX_ITER = 1000; // When the limit is not chosen per view
+// A view starts at one of these, chosen from a probe of it, and background deepening raises the
+// limit through the rest in turn. Each one is compiled in, since the limit is a template
+// parameter throughout
+inline constexpr std::array<std::size_t, 8> ITERATION_LIMITS = {
+    250, 500, MAX_ITER, 2500, 5000, 10'000, 25'000, 50'000
+};
 
 // UI Constants
 inline constexpr float LOADING_TEXT_OFFSET = 50.0f;
@@ -42,10 +69,13 @@ xsimd::batch<T> iota_batch(T start) {
   return batch_t::load_aligned(tmp);
 }
 
+// (x, y) is left at the orbit point z = x + yi reached
 template <std::size_t MAX_ITER>
-constexpr auto mandelbrot_simd =
-    [](xsimd::batch<double> a,
-       xsimd::batch<double> b) -> std::pair<xsimd::batch<std::size_t>, xsimd::batch<double>> {
+constexpr auto mandelbrot_simd = [](xsimd::batch<double> a,
+                                    xsimd::batch<double> b,
+                                    xsimd::batch<double> &x,
+                                    xsimd::batch<double> &y)
+    -> std::pair<xsimd::batch<std::size_t>, xsimd::batch<double>> {
   using batch = xsimd::batch<double>;
   using bsize = xsimd::batch<std::size_t>;
 
@@ -53,8 +83,8 @@ constexpr auto mandelbrot_simd =
   auto const two = batch(2.0);
   auto const one = bsize(1);
 
-  auto x = batch(0.0);
-  auto y = batch(0.0);
+  x = batch(0.0);
+  y = batch(0.0);
   auto iter = bsize(0);
 
   auto x2 = x * x;
@@ -84,441 +114,17 @@ constexpr auto mandelbrot_simd =
   return {iter, mag};
 };
 
-// ===== UTILITY METHODS =====
-[[nodiscard]] constexpr batch_d lerp_simd(const batch_d &a, const batch_d &b, const batch_d &f) noexcept {
-  return a + f * (b - a);
-}
-
-[[nodiscard]] batch_d labToXyz_simd(const batch_d &t) noexcept {
-  static constexpr double DELTA = 6.0 / 29.0;
-  static constexpr double DELTA_SQUARED_TIMES_3 = 3.0 * DELTA * DELTA;
-  static constexpr double OFFSET = 4.0 / 29.0;
-  
-  const auto delta = batch_d(DELTA);
-  const auto cube = t * t * t;
-  const auto linear = batch_d(DELTA_SQUARED_TIMES_3) * (t - batch_d(OFFSET));
-  return select(t > delta, cube, linear);
-}
-
-[[nodiscard]] batch_d gammaCorrect_simd(const batch_d &c) noexcept {
-  static constexpr double LINEAR_FACTOR = 12.92;
-  static constexpr double GAMMA_FACTOR = 1.055;
-  static constexpr double GAMMA_POWER = 1.0 / 2.4;
-  static constexpr double GAMMA_OFFSET = 0.055;
-  static constexpr double THRESHOLD = 0.0031308;
-  
-  const auto linear = batch_d(LINEAR_FACTOR) * c;
-  const auto gamma = batch_d(GAMMA_FACTOR) * xsimd::pow(c, batch_d(GAMMA_POWER)) - batch_d(GAMMA_OFFSET);
-  return select(c <= batch_d(THRESHOLD), linear, gamma);
-}
-
-// ===== COLOUR FUNCTIONS =====
-
-[[nodiscard]] constexpr batch_d clampNormalized(const batch_d &value) noexcept {
-  return xsimd::min(batch_d(1.0), xsimd::max(batch_d(0.0), value));
-}
-
-std::tuple<batch_d, batch_d, batch_d> getExponentialLCH_simd(const batch_d &smooth_iterations) {
-  // SIMD implementation of Smooth Exponential LCH Color algorithm
-
-  // Handle max iterations (inside set) -> black
-  auto max_iter_mask = smooth_iterations >= batch_d(static_cast<double>(MAX_ITER));
-
-  // Calculate s parameter
-  auto s = smooth_iterations / batch_d(static_cast<double>(MAX_ITER));
-
-  // Calculate v parameter: v = 1.0 - cos²(π * s)
-  auto pi_s = s * batch_d(std::numbers::pi_v<double>);
-  auto cos_pi_s = xsimd::cos(pi_s);
-  auto v = batch_d(1.0) - cos_pi_s * cos_pi_s;
-
-  // Calculate LCH parameters
-  auto L = batch_d(75.0) - (batch_d(75.0) * v);
-  auto C = batch_d(28.0) + (batch_d(75.0) - (batch_d(75.0) * v));
-  auto H = xsimd::fmod(xsimd::pow(batch_d(360.0) * s, batch_d(1.5)), batch_d(360.0));
-
-  // Convert LCH to LAB
-  auto H_rad = H * batch_d(std::numbers::pi_v<double> / 180.0);
-  auto lab_a = C * xsimd::cos(H_rad);
-  auto lab_b = C * xsimd::sin(H_rad);
-
-  // Convert LAB to XYZ
-  auto fy = (L + batch_d(16.0)) / batch_d(116.0);
-  auto fx = lab_a / batch_d(500.0) + fy;
-  auto fz = fy - lab_b / batch_d(200.0);
-
-  auto X = batch_d(0.95047) * labToXyz_simd(fx);
-  auto Y = batch_d(1.00000) * labToXyz_simd(fy);
-  auto Z = batch_d(1.08883) * labToXyz_simd(fz);
-
-  // Convert XYZ to linear RGB
-  auto R_linear = batch_d(3.2406) * X - batch_d(1.5372) * Y - batch_d(0.4986) * Z;
-  auto G_linear = batch_d(-0.9689) * X + batch_d(1.8758) * Y + batch_d(0.0415) * Z;
-  auto B_linear = batch_d(0.0557) * X - batch_d(0.2040) * Y + batch_d(1.0570) * Z;
-
-  auto R_srgb = gammaCorrect_simd(R_linear);
-  auto G_srgb = gammaCorrect_simd(G_linear);
-  auto B_srgb = gammaCorrect_simd(B_linear);
-
-  // Clamp to [0, 1] range
-  auto r = xsimd::min(batch_d(1.0), xsimd::max(batch_d(0.0), R_srgb));
-  auto g = xsimd::min(batch_d(1.0), xsimd::max(batch_d(0.0), G_srgb));
-  auto b = xsimd::min(batch_d(1.0), xsimd::max(batch_d(0.0), B_srgb));
-
-  // Apply black for max iterations
-  r = select(max_iter_mask, batch_d(0.0), r);
-  g = select(max_iter_mask, batch_d(0.0), g);
-  b = select(max_iter_mask, batch_d(0.0), b);
-
-  return {r, g, b};
-}
-
-std::tuple<batch_d, batch_d, batch_d> getClassicColor_simd(const batch_d &t) {
-  // Classic Ultra Fractal color scheme
-  const batch_d t0 = batch_d(0.16);
-  const batch_d t1 = batch_d(0.42);
-  const batch_d t2 = batch_d(0.6425);
-  const batch_d t3 = batch_d(0.8575);
-
-  // Color stops normalized to 0-1
-  const batch_d c0_r = batch_d(0.0), c0_g = batch_d(7.0 / 255.0), c0_b = batch_d(100.0 / 255.0);
-  const batch_d c1_r = batch_d(32.0 / 255.0), c1_g = batch_d(107.0 / 255.0),
-                c1_b = batch_d(203.0 / 255.0);
-  const batch_d c2_r = batch_d(237.0 / 255.0), c2_g = batch_d(1.0), c2_b = batch_d(1.0);
-  const batch_d c3_r = batch_d(1.0), c3_g = batch_d(170.0 / 255.0), c3_b = batch_d(0.0);
-  const batch_d c4_r = batch_d(0.0), c4_g = batch_d(2.0 / 255.0), c4_b = batch_d(0.0);
-  const batch_d c5_r = batch_d(0.0), c5_g = batch_d(7.0 / 255.0), c5_b = batch_d(100.0 / 255.0);
-
-  batch_d f01 = xsimd::min(batch_d(1.0), xsimd::max(batch_d(0.0), t / t0));
-  batch_d f12 = xsimd::min(batch_d(1.0), xsimd::max(batch_d(0.0), (t - t0) / (t1 - t0)));
-  batch_d f23 = xsimd::min(batch_d(1.0), xsimd::max(batch_d(0.0), (t - t1) / (t2 - t1)));
-  batch_d f34 = xsimd::min(batch_d(1.0), xsimd::max(batch_d(0.0), (t - t2) / (t3 - t2)));
-  batch_d f45 = xsimd::min(batch_d(1.0), xsimd::max(batch_d(0.0), (t - t3) / (batch_d(1.0) - t3)));
-
-  batch_d r = lerp_simd(c0_r, c1_r, f01);
-  batch_d g = lerp_simd(c0_g, c1_g, f01);
-  batch_d b = lerp_simd(c0_b, c1_b, f01);
-
-  r = select(t >= t0, lerp_simd(c1_r, c2_r, f12), r);
-  g = select(t >= t0, lerp_simd(c1_g, c2_g, f12), g);
-  b = select(t >= t0, lerp_simd(c1_b, c2_b, f12), b);
-
-  r = select(t >= t1, lerp_simd(c2_r, c3_r, f23), r);
-  g = select(t >= t1, lerp_simd(c2_g, c3_g, f23), g);
-  b = select(t >= t1, lerp_simd(c2_b, c3_b, f23), b);
-
-  r = select(t >= t2, lerp_simd(c3_r, c4_r, f34), r);
-  g = select(t >= t2, lerp_simd(c3_g, c4_g, f34), g);
-  b = select(t >= t2, lerp_simd(c3_b, c4_b, f34), b);
-
-  r = select(t >= t3, lerp_simd(c4_r, c5_r, f45), r);
-  g = select(t >= t3, lerp_simd(c4_g, c5_g, f45), g);
-  b = select(t >= t3, lerp_simd(c4_b, c5_b, f45), b);
-
-  return {r, g, b};
-}
-
-std::tuple<batch_d, batch_d, batch_d> getHotIronColor_simd(const batch_d &t) {
-  static constexpr double t0 = 0.25, t1 = 0.5, t2 = 0.75;
-  static constexpr double inv_t0 = 4.0; // 1.0 / 0.25
-  static constexpr double inv_t1_t0 = 4.0; // 1.0 / (0.5 - 0.25)
-  static constexpr double inv_t2_t1 = 4.0; // 1.0 / (0.75 - 0.5)
-  static constexpr double inv_1_t2 = 4.0; // 1.0 / (1.0 - 0.75)
-
-  static constexpr double c0_r = 0.0, c0_g = 0.0, c0_b = 0.0;
-  static constexpr double c1_r = 0.5, c1_g = 0.0, c1_b = 0.0;
-  static constexpr double c2_r = 1.0, c2_g = 0.0, c2_b = 0.0;
-  static constexpr double c3_r = 1.0, c3_g = 165.0 / 255.0, c3_b = 0.0;
-  static constexpr double c4_r = 1.0, c4_g = 1.0, c4_b = 1.0;
-
-  batch_d f01 = clampNormalized(t * batch_d(inv_t0));
-  batch_d f12 = clampNormalized((t - batch_d(t0)) * batch_d(inv_t1_t0));
-  batch_d f23 = clampNormalized((t - batch_d(t1)) * batch_d(inv_t2_t1));
-  batch_d f34 = clampNormalized((t - batch_d(t2)) * batch_d(inv_1_t2));
-
-  batch_d r = lerp_simd(batch_d(c0_r), batch_d(c1_r), f01);
-  batch_d g = lerp_simd(batch_d(c0_g), batch_d(c1_g), f01);
-  batch_d b = lerp_simd(batch_d(c0_b), batch_d(c1_b), f01);
-
-  r = select(t >= batch_d(t0), lerp_simd(batch_d(c1_r), batch_d(c2_r), f12), r);
-  g = select(t >= batch_d(t0), lerp_simd(batch_d(c1_g), batch_d(c2_g), f12), g);
-  b = select(t >= batch_d(t0), lerp_simd(batch_d(c1_b), batch_d(c2_b), f12), b);
-
-  r = select(t >= batch_d(t1), lerp_simd(batch_d(c2_r), batch_d(c3_r), f23), r);
-  g = select(t >= batch_d(t1), lerp_simd(batch_d(c2_g), batch_d(c3_g), f23), g);
-  b = select(t >= batch_d(t1), lerp_simd(batch_d(c2_b), batch_d(c3_b), f23), b);
-
-  r = select(t >= batch_d(t2), lerp_simd(batch_d(c3_r), batch_d(c4_r), f34), r);
-  g = select(t >= batch_d(t2), lerp_simd(batch_d(c3_g), batch_d(c4_g), f34), g);
-  b = select(t >= batch_d(t2), lerp_simd(batch_d(c3_b), batch_d(c4_b), f34), b);
-
-  return {r, g, b};
-}
-
-std::tuple<batch_d, batch_d, batch_d> getElectricBlueColor_simd(const batch_d &t) {
-  const batch_d c0_r = batch_d(0.0), c0_g = batch_d(0.0), c0_b = batch_d(50.0 / 255.0);
-  const batch_d c1_r = batch_d(0.0), c1_g = batch_d(100.0 / 255.0), c1_b = batch_d(1.0);
-  const batch_d c2_r = batch_d(0.0), c2_g = batch_d(1.0), c2_b = batch_d(1.0);
-
-  auto mask1 = t < batch_d(0.5);
-  auto f1 = xsimd::min(batch_d(1.0), xsimd::max(batch_d(0.0), t / batch_d(0.5)));
-  auto f2 = xsimd::min(batch_d(1.0), xsimd::max(batch_d(0.0), (t - batch_d(0.5)) / batch_d(0.5)));
-
-  auto r = select(mask1, lerp_simd(c0_r, c1_r, f1), lerp_simd(c1_r, c2_r, f2));
-  auto g = select(mask1, lerp_simd(c0_g, c1_g, f1), lerp_simd(c1_g, c2_g, f2));
-  auto b = select(mask1, lerp_simd(c0_b, c1_b, f1), lerp_simd(c1_b, c2_b, f2));
-
-  return {r, g, b};
-}
-
-std::tuple<batch_d, batch_d, batch_d> getSunsetColor_simd(const batch_d &t) {
-  const batch_d t0 = batch_d(0.33);
-  const batch_d t1 = batch_d(0.66);
-
-  const batch_d c0_r = batch_d(25.0 / 255.0), c0_g = batch_d(0.0), c0_b = batch_d(51.0 / 255.0);
-  const batch_d c1_r = batch_d(1.0), c1_g = batch_d(0.0), c1_b = batch_d(127.0 / 255.0);
-  const batch_d c2_r = batch_d(1.0), c2_g = batch_d(127.0 / 255.0), c2_b = batch_d(0.0);
-  const batch_d c3_r = batch_d(1.0), c3_g = batch_d(1.0), c3_b = batch_d(0.0);
-
-  batch_d f01 = xsimd::min(batch_d(1.0), xsimd::max(batch_d(0.0), t / t0));
-  batch_d f12 = xsimd::min(batch_d(1.0), xsimd::max(batch_d(0.0), (t - t0) / (t1 - t0)));
-  batch_d f23 = xsimd::min(batch_d(1.0), xsimd::max(batch_d(0.0), (t - t1) / (batch_d(1.0) - t1)));
-
-  batch_d r = lerp_simd(c0_r, c1_r, f01);
-  batch_d g = lerp_simd(c0_g, c1_g, f01);
-  batch_d b = lerp_simd(c0_b, c1_b, f01);
-
-  r = select(t >= t0, lerp_simd(c1_r, c2_r, f12), r);
-  g = select(t >= t0, lerp_simd(c1_g, c2_g, f12), g);
-  b = select(t >= t0, lerp_simd(c1_b, c2_b, f12), b);
-
-  r = select(t >= t1, lerp_simd(c2_r, c3_r, f23), r);
-  g = select(t >= t1, lerp_simd(c2_g, c3_g, f23), g);
-  b = select(t >= t1, lerp_simd(c2_b, c3_b, f23), b);
-
-  return {r, g, b};
-}
-
-[[nodiscard]] constexpr std::tuple<batch_d, batch_d, batch_d> getGrayscaleColor_simd(const batch_d &t) noexcept { 
-  return {t, t, t}; 
-}
-
-std::tuple<batch_d, batch_d, batch_d> getBlueWhiteColor_simd(const batch_d &t) {
-  static constexpr double c0_r = 0.0, c0_g = 50.0 / 255.0, c0_b = 150.0 / 255.0;
-  static constexpr double c1_r = 1.0, c1_g = 1.0, c1_b = 1.0;
-
-  return {
-    lerp_simd(batch_d(c0_r), batch_d(c1_r), t), 
-    lerp_simd(batch_d(c0_g), batch_d(c1_g), t), 
-    lerp_simd(batch_d(c0_b), batch_d(c1_b), t)
-  };
-}
-
-// 🌈 Rainbow Spiral - Smooth HSV rainbow with spiral effect
-std::tuple<batch_d, batch_d, batch_d> getRainbowSpiralColor_simd(const batch_d &t) {
-  // Create spiral effect with frequency modulation
-  auto spiral_t = xsimd::fmod(t * batch_d(3.0), batch_d(1.0));
-  
-  // Convert to HSV where H cycles through rainbow
-  auto hue = spiral_t * batch_d(360.0); // Full rainbow cycle
-  auto sat = batch_d(0.85) + batch_d(0.15) * xsimd::sin(t * batch_d(8.0)); // Slight saturation variation
-  auto val = batch_d(0.9) + batch_d(0.1) * xsimd::cos(t * batch_d(12.0)); // Slight brightness variation
-  
-  // Simple HSV to RGB conversion for hue cycling
-  auto h_norm = xsimd::fmod(hue / batch_d(60.0), batch_d(6.0));
-  auto chroma = val * sat;
-  auto x = chroma * (batch_d(1.0) - xsimd::abs(xsimd::fmod(h_norm, batch_d(2.0)) - batch_d(1.0)));
-  auto m = val - chroma;
-  
-  // Determine RGB based on hue sector
-  auto mask0 = h_norm < batch_d(1.0);
-  auto mask1 = (h_norm >= batch_d(1.0)) & (h_norm < batch_d(2.0));
-  auto mask2 = (h_norm >= batch_d(2.0)) & (h_norm < batch_d(3.0));
-  auto mask3 = (h_norm >= batch_d(3.0)) & (h_norm < batch_d(4.0));
-  auto mask4 = (h_norm >= batch_d(4.0)) & (h_norm < batch_d(5.0));
-  
-  auto r = select(mask0, chroma, select(mask1, x, select(mask2, batch_d(0.0), select(mask3, batch_d(0.0), select(mask4, x, chroma))))) + m;
-  auto g = select(mask0, x, select(mask1, chroma, select(mask2, chroma, select(mask3, x, select(mask4, batch_d(0.0), batch_d(0.0)))))) + m;
-  auto b = select(mask0, batch_d(0.0), select(mask1, batch_d(0.0), select(mask2, x, select(mask3, chroma, select(mask4, chroma, x))))) + m;
-  
-  return {r, g, b};
-}
-
-// 🌊 Ocean Depths - Deep blues to aqua to white foam
-std::tuple<batch_d, batch_d, batch_d> getOceanDepthsColor_simd(const batch_d &t) {
-  static constexpr double t0 = 0.3, t1 = 0.6, t2 = 0.85;
-  
-  // Deep ocean blue → Turquoise → Aqua → White foam
-  static constexpr double c0_r = 0.0, c0_g = 0.1, c0_b = 0.3;      // Deep blue
-  static constexpr double c1_r = 0.0, c1_g = 0.4, c1_b = 0.7;      // Medium blue
-  static constexpr double c2_r = 0.0, c2_g = 0.8, c2_b = 0.9;      // Turquoise  
-  static constexpr double c3_r = 0.7, c3_g = 1.0, c3_b = 1.0;      // Light aqua
-  static constexpr double c4_r = 1.0, c4_g = 1.0, c4_b = 1.0;      // White foam
-  
-  auto f01 = clampNormalized(t / batch_d(t0));
-  auto f12 = clampNormalized((t - batch_d(t0)) / batch_d(t1 - t0));
-  auto f23 = clampNormalized((t - batch_d(t1)) / batch_d(t2 - t1));
-  auto f34 = clampNormalized((t - batch_d(t2)) / batch_d(1.0 - t2));
-  
-  auto r = lerp_simd(batch_d(c0_r), batch_d(c1_r), f01);
-  auto g = lerp_simd(batch_d(c0_g), batch_d(c1_g), f01);
-  auto b = lerp_simd(batch_d(c0_b), batch_d(c1_b), f01);
-  
-  r = select(t >= batch_d(t0), lerp_simd(batch_d(c1_r), batch_d(c2_r), f12), r);
-  g = select(t >= batch_d(t0), lerp_simd(batch_d(c1_g), batch_d(c2_g), f12), g);
-  b = select(t >= batch_d(t0), lerp_simd(batch_d(c1_b), batch_d(c2_b), f12), b);
-  
-  r = select(t >= batch_d(t1), lerp_simd(batch_d(c2_r), batch_d(c3_r), f23), r);
-  g = select(t >= batch_d(t1), lerp_simd(batch_d(c2_g), batch_d(c3_g), f23), g);
-  b = select(t >= batch_d(t1), lerp_simd(batch_d(c2_b), batch_d(c3_b), f23), b);
-  
-  r = select(t >= batch_d(t2), lerp_simd(batch_d(c3_r), batch_d(c4_r), f34), r);
-  g = select(t >= batch_d(t2), lerp_simd(batch_d(c3_g), batch_d(c4_g), f34), g);
-  b = select(t >= batch_d(t2), lerp_simd(batch_d(c3_b), batch_d(c4_b), f34), b);
-  
-  return {r, g, b};
-}
-
-// 🔥 Lava Flow - Black → deep red → orange → yellow → white
-std::tuple<batch_d, batch_d, batch_d> getLavaFlowColor_simd(const batch_d &t) {
-  static constexpr double t0 = 0.2, t1 = 0.4, t2 = 0.7, t3 = 0.9;
-  
-  // Volcanic progression
-  static constexpr double c0_r = 0.05, c0_g = 0.0, c0_b = 0.0;     // Nearly black
-  static constexpr double c1_r = 0.4, c1_g = 0.0, c1_b = 0.0;      // Deep red
-  static constexpr double c2_r = 0.8, c2_g = 0.2, c2_b = 0.0;      // Orange-red
-  static constexpr double c3_r = 1.0, c3_g = 0.6, c3_b = 0.0;      // Orange
-  static constexpr double c4_r = 1.0, c4_g = 1.0, c4_b = 0.4;      // Yellow
-  static constexpr double c5_r = 1.0, c5_g = 1.0, c5_b = 1.0;      // White hot
-  
-  auto f01 = clampNormalized(t / batch_d(t0));
-  auto f12 = clampNormalized((t - batch_d(t0)) / batch_d(t1 - t0));
-  auto f23 = clampNormalized((t - batch_d(t1)) / batch_d(t2 - t1));
-  auto f34 = clampNormalized((t - batch_d(t2)) / batch_d(t3 - t2));
-  auto f45 = clampNormalized((t - batch_d(t3)) / batch_d(1.0 - t3));
-  
-  auto r = lerp_simd(batch_d(c0_r), batch_d(c1_r), f01);
-  auto g = lerp_simd(batch_d(c0_g), batch_d(c1_g), f01);
-  auto b = lerp_simd(batch_d(c0_b), batch_d(c1_b), f01);
-  
-  r = select(t >= batch_d(t0), lerp_simd(batch_d(c1_r), batch_d(c2_r), f12), r);
-  g = select(t >= batch_d(t0), lerp_simd(batch_d(c1_g), batch_d(c2_g), f12), g);
-  b = select(t >= batch_d(t0), lerp_simd(batch_d(c1_b), batch_d(c2_b), f12), b);
-  
-  r = select(t >= batch_d(t1), lerp_simd(batch_d(c2_r), batch_d(c3_r), f23), r);
-  g = select(t >= batch_d(t1), lerp_simd(batch_d(c2_g), batch_d(c3_g), f23), g);
-  b = select(t >= batch_d(t1), lerp_simd(batch_d(c2_b), batch_d(c3_b), f23), b);
-  
-  r = select(t >= batch_d(t2), lerp_simd(batch_d(c3_r), batch_d(c4_r), f34), r);
-  g = select(t >= batch_d(t2), lerp_simd(batch_d(c3_g), batch_d(c4_g), f34), g);
-  b = select(t >= batch_d(t2), lerp_simd(batch_d(c3_b), batch_d(c4_b), f34), b);
-  
-  r = select(t >= batch_d(t3), lerp_simd(batch_d(c4_r), batch_d(c5_r), f45), r);
-  g = select(t >= batch_d(t3), lerp_simd(batch_d(c4_g), batch_d(c5_g), f45), g);
-  b = select(t >= batch_d(t3), lerp_simd(batch_d(c4_b), batch_d(c5_b), f45), b);
-  
-  return {r, g, b};
-}
-
-// 🌸 Cherry Blossom - Soft pinks and whites with touches of green
-std::tuple<batch_d, batch_d, batch_d> getCherryBlossomColor_simd(const batch_d &t) {
-  static constexpr double t0 = 0.25, t1 = 0.5, t2 = 0.75;
-  
-  // Delicate spring colors
-  static constexpr double c0_r = 0.2, c0_g = 0.4, c0_b = 0.2;      // Soft green
-  static constexpr double c1_r = 0.9, c1_g = 0.7, c1_b = 0.8;      // Light pink
-  static constexpr double c2_r = 1.0, c2_g = 0.8, c2_b = 0.9;      // Pale pink
-  static constexpr double c3_r = 0.95, c3_g = 0.5, c3_b = 0.7;     // Cherry blossom pink
-  static constexpr double c4_r = 1.0, c4_g = 1.0, c4_b = 1.0;      // Pure white
-  
-  auto f01 = clampNormalized(t / batch_d(t0));
-  auto f12 = clampNormalized((t - batch_d(t0)) / batch_d(t1 - t0));
-  auto f23 = clampNormalized((t - batch_d(t1)) / batch_d(t2 - t1));
-  auto f34 = clampNormalized((t - batch_d(t2)) / batch_d(1.0 - t2));
-  
-  auto r = lerp_simd(batch_d(c0_r), batch_d(c1_r), f01);
-  auto g = lerp_simd(batch_d(c0_g), batch_d(c1_g), f01);
-  auto b = lerp_simd(batch_d(c0_b), batch_d(c1_b), f01);
-  
-  r = select(t >= batch_d(t0), lerp_simd(batch_d(c1_r), batch_d(c2_r), f12), r);
-  g = select(t >= batch_d(t0), lerp_simd(batch_d(c1_g), batch_d(c2_g), f12), g);
-  b = select(t >= batch_d(t0), lerp_simd(batch_d(c1_b), batch_d(c2_b), f12), b);
-  
-  r = select(t >= batch_d(t1), lerp_simd(batch_d(c2_r), batch_d(c3_r), f23), r);
-  g = select(t >= batch_d(t1), lerp_simd(batch_d(c2_g), batch_d(c3_g), f23), g);
-  b = select(t >= batch_d(t1), lerp_simd(batch_d(c2_b), batch_d(c3_b), f23), b);
-  
-  r = select(t >= batch_d(t2), lerp_simd(batch_d(c3_r), batch_d(c4_r), f34), r);
-  g = select(t >= batch_d(t2), lerp_simd(batch_d(c3_g), batch_d(c4_g), f34), g);
-  b = select(t >= batch_d(t2), lerp_simd(batch_d(c3_b), batch_d(c4_b), f34), b);
-  
-  return {r, g, b};
-}
-
-// ⚡ Neon Cyberpunk - Electric purple/blue/cyan for futuristic vibes  
-std::tuple<batch_d, batch_d, batch_d> getNeonCyberpunkColor_simd(const batch_d &t) {
-  static constexpr double t0 = 0.3, t1 = 0.6;
-  
-  // Cyberpunk neon colors
-  static constexpr double c0_r = 0.1, c0_g = 0.0, c0_b = 0.2;      // Dark purple
-  static constexpr double c1_r = 0.5, c1_g = 0.0, c1_b = 1.0;      // Electric purple
-  static constexpr double c2_r = 0.0, c2_g = 0.5, c2_b = 1.0;      // Electric blue
-  static constexpr double c3_r = 0.0, c3_g = 1.0, c3_b = 1.0;      // Cyan
-  static constexpr double c4_r = 1.0, c4_g = 1.0, c4_b = 1.0;      // White glow
-  
-  auto f01 = clampNormalized(t / batch_d(t0));
-  auto f12 = clampNormalized((t - batch_d(t0)) / batch_d(t1 - t0));
-  auto f23 = clampNormalized((t - batch_d(t1)) / batch_d(1.0 - t1));
-  
-  auto r = lerp_simd(batch_d(c0_r), batch_d(c1_r), f01);
-  auto g = lerp_simd(batch_d(c0_g), batch_d(c1_g), f01);
-  auto b = lerp_simd(batch_d(c0_b), batch_d(c1_b), f01);
-  
-  r = select(t >= batch_d(t0), lerp_simd(batch_d(c1_r), batch_d(c2_r), f12), r);
-  g = select(t >= batch_d(t0), lerp_simd(batch_d(c1_g), batch_d(c2_g), f12), g);
-  b = select(t >= batch_d(t0), lerp_simd(batch_d(c1_b), batch_d(c2_b), f12), b);
-  
-  r = select(t >= batch_d(t1), lerp_simd(batch_d(c2_r), batch_d(c4_r), f23), r);
-  g = select(t >= batch_d(t1), lerp_simd(batch_d(c2_g), batch_d(c4_g), f23), g);
-  b = select(t >= batch_d(t1), lerp_simd(batch_d(c2_b), batch_d(c4_b), f23), b);
-  
-  return {r, g, b};
-}
-
-// 🍂 Autumn Forest - Rich browns, oranges, golds, and deep reds
-std::tuple<batch_d, batch_d, batch_d> getAutumnForestColor_simd(const batch_d &t) {
-  static constexpr double t0 = 0.2, t1 = 0.4, t2 = 0.7;
-  
-  // Autumn foliage colors
-  static constexpr double c0_r = 0.2, c0_g = 0.1, c0_b = 0.05;     // Dark brown
-  static constexpr double c1_r = 0.6, c1_g = 0.3, c1_b = 0.1;      // Rich brown
-  static constexpr double c2_r = 0.8, c2_g = 0.4, c2_b = 0.1;      // Orange-brown
-  static constexpr double c3_r = 1.0, c3_g = 0.6, c3_b = 0.0;      // Golden orange
-  static constexpr double c4_r = 0.8, c4_g = 0.2, c4_b = 0.1;      // Deep red
-  static constexpr double c5_r = 1.0, c5_g = 0.8, c5_b = 0.4;      // Golden yellow
-  
-  auto f01 = clampNormalized(t / batch_d(t0));
-  auto f12 = clampNormalized((t - batch_d(t0)) / batch_d(t1 - t0));
-  auto f23 = clampNormalized((t - batch_d(t1)) / batch_d(t2 - t1));
-  auto f34 = clampNormalized((t - batch_d(t2)) / batch_d(1.0 - t2));
-  
-  auto r = lerp_simd(batch_d(c0_r), batch_d(c1_r), f01);
-  auto g = lerp_simd(batch_d(c0_g), batch_d(c1_g), f01);
-  auto b = lerp_simd(batch_d(c0_b), batch_d(c1_b), f01);
-  
-  r = select(t >= batch_d(t0), lerp_simd(batch_d(c1_r), batch_d(c2_r), f12), r);
-  g = select(t >= batch_d(t0), lerp_simd(batch_d(c1_g), batch_d(c2_g), f12), g);
-  b = select(t >= batch_d(t0), lerp_simd(batch_d(c1_b), batch_d(c2_b), f12), b);
-  
-  r = select(t >= batch_d(t1), lerp_simd(batch_d(c2_r), batch_d(c3_r), f23), r);
-  g = select(t >= batch_d(t1), lerp_simd(batch_d(c2_g), batch_d(c3_g), f23), g);
-  b = select(t >= batch_d(t1), lerp_simd(batch_d(c2_b), batch_d(c3_b), f23), b);
-  
-  r = select(t >= batch_d(t2), lerp_simd(batch_d(c3_r), batch_d(c5_r), f34), r);
-  g = select(t >= batch_d(t2), lerp_simd(batch_d(c3_g), batch_d(c5_g), f34), g);
-  b = select(t >= batch_d(t2), lerp_simd(batch_d(c3_b), batch_d(c5_b), f34), b);
-  
-  return {r, g, b};
+/// Calls f.template operator()<N>() with N = limit, which must be one of ITERATION_LIMITS.
+template <std::size_t I = 0>
+auto with_iteration_limit(std::size_t limit, auto &&f) -> decltype(auto) {
+  if constexpr (I + 1 == ITERATION_LIMITS.size()) {
+    return f.template operator()<ITERATION_LIMITS[I]>();
+  } else {
+    if (limit == ITERATION_LIMITS[I]) {
+      return f.template operator()<ITERATION_LIMITS[I]>();
+    }
+    return with_iteration_limit<I + 1>(limit, f);
+  }
 }
 
 } // namespace
@@ -531,13 +137,20 @@ private:
   static constexpr double DEFAULT_CENTER_X = -0.7;
   static constexpr double DEFAULT_CENTER_Y = 0.0;
   static constexpr double DEFAULT_ZOOM = 0.8;
-  static constexpr auto RENDER_DELAY = std::chrono::milliseconds(150);
+  static constexpr auto FRAME_BUDGET = std::chrono::milliseconds(16);
 
   // Rendering constants
   static constexpr int MAX_AA_SAMPLES = 4;
+  static constexpr std::size_t TEMPORAL_AA_SAMPLES = 64;
+  static constexpr std::size_t TILE_CACHE_BYTES = 256uz << 20;
+  static constexpr std::size_t TILE_STORE_BYTES = 4uz << 30;
   static constexpr double ZOOM_IN_FACTOR = 1.25;
   static constexpr double ZOOM_OUT_FACTOR = 0.8;
   static constexpr double VIEWPORT_SCALE = 3.0;
+  static constexpr std::size_t DEEPEN_SLICE_ITERATIONS = 1uz << 24; // Work between time checks
+  static constexpr double DEEPEN_STOP_FRACTION = 0.001;
+  static constexpr std::size_t STREAM_QUEUE_CAPACITY = 1024; // Finished tiles awaiting upload
+  static constexpr std::size_t PAN_COST_STRIDE = 4; // Pixels between cost samples while panning
 
   // ===== ENUMS =====
   enum class ColorScheme : int {
@@ -557,6 +170,10 @@ private:
     COUNT
   };
 
+  static_assert(
+      static_cast<int>(ColorScheme::COUNT) == static_cast<int>(mandelbrot::colour::scheme::count)
+  );
+
   enum class AntiAliasingLevel : int { X1 = 1, X4 = 2, X9 = 3, X16 = 4 };
 
   [[nodiscard]] static constexpr int toSamples(AntiAliasingLevel level) noexcept {
@@ -572,11 +189,39 @@ private:
   // ===== GRAPHICS COMPONENTS =====
   sf::RenderWindow window;
   sf::Image image;
+  sf::Image pan_row; // Scratch for a row panned sideways, which cannot be copied onto itself
   sf::Texture texture;
   sf::Sprite sprite;
+  // Pixel rectangles of a streamed frame that are coloured and ready to upload
+  mandelbrot::completion_queue<mandelbrot::tile::rect> finished_tiles{STREAM_QUEUE_CAPACITY};
+  std::vector<sf::Uint8> upload_buffer;
 
   // ===== COMPUTATION =====
-  std::unique_ptr<exec::static_thread_pool> thread_pool;
+  std::unique_ptr<mandelbrot::backend_pool> thread_pool;
+  std::array<mandelbrot::colour::palette, mandelbrot::colour::SCHEME_COUNT> palettes =
+      mandelbrot::colour::build_palettes<MAX_ITER>();
+  mandelbrot::backend current_backend = mandelbrot::backend::stdexec;
+  mandelbrot::tile::iteration_map iteration_map;
+  mandelbrot::tile::iteration_map adaptive_centres; // One sample per pixel for adaptive AA
+  mandelbrot::tile::iteration_map temporal_map;     // Latest jittered sample for temporal AA
+  mandelbrot::tile::accumulator temporal;
+  std::chrono::steady_clock::time_point temporal_start;
+  std::size_t temporal_row = 0; // First row of the jittered frame not yet accumulated
+  mandelbrot::tile::cost_model cost_model;
+  std::unique_ptr<mandelbrot::tile::tile_store> tile_store; // Persists the cache across runs
+  mandelbrot::tile::tile_cache tile_cache{TILE_CACHE_BYTES};
+  std::vector<std::size_t> pixel_cost;
+  std::vector<mandelbrot::tile::rect> pending_regions; // Progressive work, next band at the back
+  std::chrono::steady_clock::time_point progressive_start;
+  mandelbrot::tile::quality_governor governor{FRAME_BUDGET};
+  mandelbrot::tile::iteration_map preview_map;
+  double preview_block = 1.0; // Pixels per side of the coarsest detail on screen, 1 once refined
+  std::size_t iteration_limit = MAX_ITER;
+  mandelbrot::tile::interior interior; // Samples still inside, being run on to the next limit
+  bool interior_found = false;
+  bool deepening_finished = false;
+  std::size_t deepened = 0; // Samples of `interior` already run on in the current step
+  std::chrono::steady_clock::time_point deepening_start;
 
   // ===== VIEWPORT STATE =====
   double center_x = DEFAULT_CENTER_X;
@@ -590,13 +235,23 @@ private:
   bool anti_aliasing_enabled = false;
   bool smooth_coloring_enabled = false;
   AntiAliasingLevel aa_level = AntiAliasingLevel::X1;
+  bool adaptive_aa_enabled = false;
+  bool temporal_aa_enabled = false;
+  bool tile_cache_enabled = false;
+  bool deepening_enabled = true;
+  bool auto_limit_enabled = true;
+  double refined_fraction = 0.0;
+  mandelbrot::tile::strategy render_strategy = mandelbrot::tile::strategy::brute_force;
+  double iterated_fraction = 1.0;
+  double idle_fraction = 0.0;
 
   // ===== INTERACTION STATE =====
   bool is_dragging = false;
   bool is_rendering = false;
   bool is_panning = false;
+  bool had_input = false; // A pan or zoom arrived this frame
   sf::Vector2i last_mouse_pos;
-  std::chrono::steady_clock::time_point last_pan_time;
+  sf::Vector2i pending_pan; // Pixels dragged since the last frame
 
   // ===== UI ELEMENTS =====
   sf::Font font;
@@ -609,17 +264,21 @@ public:
   MandelbrotViewer()
       : window(sf::VideoMode(DEFAULT_WIDTH, DEFAULT_HEIGHT), "Mandelbrot Viewer"),
         thread_pool(
-            std::make_unique<exec::static_thread_pool>(std::thread::hardware_concurrency())
+            std::make_unique<mandelbrot::backend_pool>(std::thread::hardware_concurrency())
         ) {
     initializeGraphics();
     setupUI();
+    iteration_map.keep_orbits(deepening_enabled);
     render();
   }
 
   void run() {
     while (window.isOpen()) {
       handleEvents();
-      checkDelayedRender();
+      applyPendingPan();
+      renderPendingRegions();
+      deepenInterior();
+      accumulateTemporalSample();
       draw();
     }
   }
@@ -683,7 +342,7 @@ private:
 
   void setupHelpTexts(bool font_loaded, bool monospace_font_loaded) {
     // Create help text content
-    static constexpr std::array<std::string_view, 30> help_content = {
+    static constexpr std::array<std::string_view, 37> help_content = {
         "MANDELBROT VIEWER - CONTROLS",
         "",
         "Navigation:",
@@ -695,6 +354,13 @@ private:
         "  S                - Toggle smooth coloring on/off",
         "  A                - Toggle anti-aliasing",
         "  Q                - Cycle anti-aliasing quality",
+        "  V                - Toggle adaptive anti-aliasing",
+        "  T                - Toggle temporal anti-aliasing (refines while idle)",
+        "  M                - Cycle render strategy",
+        "  B                - Cycle scheduler backend",
+        "  K                - Toggle world tile cache",
+        "  D                - Toggle background deepening of the interior",
+        "  L                - Toggle automatic iteration limit (else 1000)",
         "",
         "Color Schemes:",
         "  C                - Cycle color schemes",
@@ -759,6 +425,7 @@ private:
 
   // ===== EVENT HANDLING =====
   void handleEvents() {
+    had_input = false;
     sf::Event event{};
     while (window.pollEvent(event)) {
       switch (event.type) {
@@ -807,10 +474,7 @@ private:
 
   void stopDragging() {
     is_dragging = false;
-    if (is_panning) {
-      is_panning = false;
-      render();
-    }
+    is_panning = false;
   }
 
   void handleKeyPress(sf::Keyboard::Key key) {
@@ -819,7 +483,7 @@ private:
       const auto max_scheme = static_cast<int>(ColorScheme::COUNT);
       if (scheme_index >= 0 && scheme_index < max_scheme) {
         current_color_scheme = static_cast<ColorScheme>(scheme_index);
-        render();
+        recolour();
       }
     } else if (key == sf::Keyboard::Num0) {
       // Key 0 maps to scheme index 9 (10th scheme)
@@ -827,7 +491,7 @@ private:
       const auto max_scheme = static_cast<int>(ColorScheme::COUNT);
       if (scheme_index < max_scheme) {
         current_color_scheme = static_cast<ColorScheme>(scheme_index);
-        render();
+        recolour();
       }
     } else {
       switch (key) {
@@ -840,6 +504,27 @@ private:
       case sf::Keyboard::Q:
         cycleAntiAliasingLevel();
         break;
+      case sf::Keyboard::V:
+        toggleAdaptiveAntiAliasing();
+        break;
+      case sf::Keyboard::T:
+        toggleTemporalAntiAliasing();
+        break;
+      case sf::Keyboard::M:
+        cycleRenderStrategy();
+        break;
+      case sf::Keyboard::B:
+        cycleBackend();
+        break;
+      case sf::Keyboard::K:
+        toggleTileCache();
+        break;
+      case sf::Keyboard::D:
+        toggleDeepening();
+        break;
+      case sf::Keyboard::L:
+        toggleAutoLimit();
+        break;
       case sf::Keyboard::C:
         cycleColorScheme();
         break;
@@ -859,6 +544,8 @@ private:
 
   // ===== NAVIGATION =====
   void handleZoom(float delta, int mouse_x, int mouse_y) {
+    // The frame a zoom resamples must show the centre the zoom starts from
+    applyPendingPan();
     auto screenToComplex = [&](int screen_x, int screen_y) -> std::pair<double, double> {
       const double scale = VIEWPORT_SCALE / (zoom * std::min(current_width, current_height));
       const double real = center_x + (screen_x - current_width / 2.0) * scale;
@@ -866,19 +553,23 @@ private:
       return {real, imag};
     };
     auto [old_real, old_imag] = screenToComplex(mouse_x, mouse_y);
+    const double old_zoom = zoom;
     zoom *= (delta > 0) ? ZOOM_IN_FACTOR : ZOOM_OUT_FACTOR;
     auto [new_real, new_imag] = screenToComplex(mouse_x, mouse_y);
     center_x += old_real - new_real;
     center_y += old_imag - new_imag;
-    render();
+    had_input = true;
+    renderZoom(old_zoom / zoom, mouse_x, mouse_y);
   }
 
   void handlePan(int dx, int dy) {
     double scale = VIEWPORT_SCALE / (zoom * std::min(current_width, current_height));
     center_x -= dx * scale;
     center_y += dy * scale;
+    pending_pan.x += dx;
+    pending_pan.y += dy;
     is_panning = true;
-    last_pan_time = std::chrono::steady_clock::now();
+    had_input = true;
   }
 
   void handleResize(unsigned int new_width, unsigned int new_height) {
@@ -923,43 +614,141 @@ private:
     render();
   }
 
+  void toggleAdaptiveAntiAliasing() {
+    adaptive_aa_enabled = !adaptive_aa_enabled;
+    render();
+  }
+
+  void toggleTemporalAntiAliasing() {
+    temporal_aa_enabled = !temporal_aa_enabled;
+    render();
+  }
+
+  void cycleRenderStrategy() {
+    int next_strategy = (static_cast<int>(render_strategy) + 1) %
+                        static_cast<int>(mandelbrot::tile::strategy::count);
+    render_strategy = static_cast<mandelbrot::tile::strategy>(next_strategy);
+    render();
+  }
+
+  void cycleBackend() {
+    // Skip backends that were not enabled at build time
+    auto next = current_backend;
+    do {
+      next = static_cast<mandelbrot::backend>(
+          (static_cast<int>(next) + 1) % static_cast<int>(mandelbrot::backend::count)
+      );
+    } while (!mandelbrot::available(next));
+    current_backend = next;
+    render();
+  }
+
+  void toggleTileCache() {
+    tile_cache_enabled = !tile_cache_enabled;
+    if (tile_cache_enabled && !tile_store) {
+      openTileStore();
+    }
+    tile_cache.reset_stats();
+    render();
+  }
+
+  /// Backs the tile cache with the on-disk store; without one the cache stays in memory only.
+  void openTileStore() {
+    auto const *xdg_cache = std::getenv("XDG_CACHE_HOME");
+    auto const *home = std::getenv("HOME");
+    if (xdg_cache == nullptr && home == nullptr) {
+      return;
+    }
+    auto const base = xdg_cache != nullptr ? std::filesystem::path(xdg_cache)
+                                           : std::filesystem::path(home) / ".cache";
+    try {
+      tile_store = std::make_unique<mandelbrot::tile::tile_store>(
+          base / "mandelbrot" / "tiles", TILE_STORE_BYTES
+      );
+      tile_cache.set_backing(tile_store.get());
+    } catch (std::exception const &e) {
+      std::cerr << "Tile store unavailable, caching in memory only: " << e.what() << '\n';
+    }
+  }
+
+  /// Turning deepening off goes back to the starting limit.
+  void toggleDeepening() {
+    deepening_enabled = !deepening_enabled;
+    iteration_map.keep_orbits(deepening_enabled);
+    if (deepening_enabled) {
+      restartDeepening();
+    } else {
+      render();
+    }
+  }
+
+  void toggleAutoLimit() {
+    auto_limit_enabled = !auto_limit_enabled;
+    render();
+  }
+
   void cycleColorScheme() {
     int next_scheme =
         (static_cast<int>(current_color_scheme) + 1) % static_cast<int>(ColorScheme::COUNT);
     current_color_scheme = static_cast<ColorScheme>(next_scheme);
-    render();
+    recolour();
   }
 
   void toggleSmoothColoring() {
     smooth_coloring_enabled = !smooth_coloring_enabled;
-    render();
+    // Adaptive AA picks the pixels to refine by colour contrast, which depends on the mode; a
+    // shortcut strategy's map for band colouring has filled bands smooth colouring cannot use
+    if (adaptiveActive() || (isTiled() && smooth_coloring_enabled)) {
+      render();
+    } else {
+      recolour();
+    }
   }
 
   void toggleHelp() { show_help = !show_help; }
 
   // ===== RENDERING =====
-  void checkDelayedRender() {
-    if (is_panning) {
-      auto now = std::chrono::steady_clock::now();
-      auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_pan_time);
-      if (elapsed >= RENDER_DELAY) {
-        is_panning = false;
-        render();
-      }
+  void applyPendingPan() {
+    if (pending_pan.x != 0 || pending_pan.y != 0) {
+      renderPan(pending_pan.x, pending_pan.y);
+      pending_pan = {0, 0};
     }
   }
 
   void render() {
+    pending_pan = {0, 0}; // The new frame is drawn at the centre the pan already moved
+    pending_regions.clear();
+    restartDeepening();
     is_rendering = true;
     showLoadingIndicator();
 
     auto start_time = std::chrono::high_resolution_clock::now();
 
-    int samples_per_side = anti_aliasing_enabled ? static_cast<int>(aa_level) : 1;
-
-    renderUnified(samples_per_side);
-
-    texture.update(image);
+    setIterationLimit(auto_limit_enabled ? chooseLimit() : MAX_ITER);
+    preview_block = 1.0;
+
+    int samples_per_side = samplesPerSide();
+
+    if (tile_cache_enabled) {
+      iteration_map.resize(current_width * samples_per_side, current_height * samples_per_side);
+      renderCached(fullFrame());
+      presentFrame();
+    } else if (adaptiveActive()) {
+      iteration_map.resize(current_width * samples_per_side, current_height * samples_per_side);
+      auto const refined = renderAdaptive(fullFrame());
+      refined_fraction = static_cast<double>(refined) / (current_width * current_height);
+      presentFrame();
+    } else if (render_strategy == mandelbrot::tile::strategy::brute_force) {
+      iteration_map.resize(current_width * samples_per_side, current_height * samples_per_side);
+      streamFrame([&] { renderUnified(samples_per_side, fullFrame(), true); });
+      cost_model.record(currentViewport(), pixel_cost);
+    } else if (mandelbrot::tile::TILE_SIZE % static_cast<std::size_t>(samples_per_side) == 0) {
+      streamFrame([&] { renderTiled(samples_per_side, true); });
+    } else {
+      // Tiles of the sample grid would split pixels
+      renderTiled(samples_per_side);
+      presentFrame();
+    }
 
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
@@ -968,75 +757,790 @@ private:
     updateWindowTitle(duration.count());
   }
 
-  void renderUnified(int samples_per_side) {
+  /// Pans by whole pixels: the frame buffers are shifted and only the exposed strips are computed,
+  /// at full quality if the governor expects that to fit the frame, else as a preview that is
+  /// refined once input stops.
+  void renderPan(int dx, int dy) {
+    auto const width = static_cast<int>(current_width);
+    auto const height = static_cast<int>(current_height);
+    if (std::abs(dx) >= width || std::abs(dy) >= height || !frameBuffersMatch()) {
+      render();
+      return;
+    }
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    restartDeepening();
+    shiftImage(dx, dy);
+    auto const n = static_cast<std::ptrdiff_t>(samplesPerSide());
+    iteration_map.shift(dx * n, dy * n);
+    if (usesPixelCost()) {
+      mandelbrot::tile::shift_pixels(std::span(pixel_cost), current_width, current_height, dx, dy);
+    }
+    shiftPendingRegions(dx, dy);
+
+    auto const strips = mandelbrot::tile::exposed_strips(current_width, current_height, dx, dy);
+    auto exposed = std::size_t{0};
+    for (auto const &strip : strips) {
+      exposed += strip.area();
+    }
+    auto const factor = governor.factor(exposed);
+    if (factor == 1 && samplesPerSide() == 1) {
+      for (auto const &strip : strips) {
+        renderRegion(strip);
+      }
+      if (usesPixelCost()) {
+        // Every pan frame records, so a sample of the map will do
+        cost_model.record(currentViewport(), pixel_cost, PAN_COST_STRIDE);
+      }
+    } else {
+      if (pending_regions.empty()) {
+        progressive_start = std::chrono::steady_clock::now();
+      }
+      for (auto const &strip : strips) {
+        renderPreview(strip, factor);
+        queueRegion(strip);
+      }
+      preview_block = std::max(preview_block, static_cast<double>(factor));
+    }
+
+    presentFrame();
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    updateWindowTitle(
+        std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count()
+    );
+  }
+
+  /// Moves the image by (dx, dy) in place, walking rows against the motion as shift_pixels does.
+  /// A row moving only sideways overlaps itself, so it goes through `pan_row`.
+  void shiftImage(int dx, int dy) {
+    auto const width = static_cast<int>(current_width);
+    auto const height = static_cast<int>(current_height);
+    auto const columns = width - std::abs(dx);
+    if (dy == 0 && pan_row.getSize().x != current_width) {
+      pan_row.create(current_width, 1);
+    }
+    for (int i = 0; i != height - std::abs(dy); ++i) {
+      auto const dst_y = dy > 0 ? height - 1 - i : i;
+      auto const source = sf::IntRect(std::max(-dx, 0), dst_y - dy, columns, 1);
+      if (dy == 0) {
+        pan_row.copy(image, 0, 0, source);
+        image.copy(pan_row, std::max(dx, 0), dst_y, sf::IntRect(0, 0, columns, 1));
+      } else {
+        image.copy(image, std::max(dx, 0), dst_y, source);
+      }
+    }
+  }
+
+  /// Shows the previous frame resampled about the mouse point at once and queues the rest for
+  /// progressive rendering. Zooming out keeps the pixels the previous frame fully covers. Where
+  /// the governor can fit a preview sharper than the resampled frame, that is shown instead.
+  void renderZoom(double ratio, int mouse_x, int mouse_y) {
+    if (!frameBuffersMatch()) {
+      render();
+      return;
+    }
+    auto const start_time = std::chrono::high_resolution_clock::now();
+    restartDeepening();
+    auto const was_complete = pending_regions.empty();
+    auto const mx = static_cast<double>(mouse_x);
+    auto const my = static_cast<double>(mouse_y);
+
+    using rgba = std::array<sf::Uint8, 4>;
+    auto const pixel_count = current_width * current_height;
+    auto previous = std::vector<rgba>(pixel_count);
+    auto resampled = std::vector<rgba>(pixel_count);
+    std::memcpy(previous.data(), image.getPixelsPtr(), pixel_count * sizeof(rgba));
+    mandelbrot::tile::resample_zoom<rgba>(
+        previous, resampled, current_width, current_height, mx, my, ratio, {0, 0, 0, 255}
+    );
+    image.create(current_width, current_height, resampled.front().data());
+
+    auto const n = static_cast<double>(samplesPerSide());
+    auto const resample = [&]<typename T>(std::vector<T> &values) {
+      auto const old_values = values;
+      mandelbrot::tile::resample_zoom<T>(
+          old_values,
+          values,
+          iteration_map.width,
+          iteration_map.height,
+          mx * n,
+          my * n,
+          ratio,
+          T{}
+      );
+    };
+    resample(iteration_map.iter);
+    resample(iteration_map.mag);
+    iteration_map.forget_orbits(0, iteration_map.iter.size());
+    if (usesPixelCost()) {
+      auto const old_cost = pixel_cost;
+      mandelbrot::tile::resample_zoom<std::size_t>(
+          old_cost, pixel_cost, current_width, current_height, mx, my, ratio, 0
+      );
+    }
+
+    // A frame still filling in holds preview pixels, so nothing in it can be trusted as known
+    auto const known = was_complete ? mandelbrot::tile::zoom_covered(
+                                          current_width, current_height, mx, my, ratio
+                                      )
+                                    : mandelbrot::tile::rect{};
+    // Zooming out can lower the limit at once; deepening raises it where the new view needs it
+    if (auto_limit_enabled && ratio > 1.0) {
+      auto const wanted = chooseLimit();
+      if (wanted < iteration_limit) {
+        mandelbrot::tile::lower_limit(iteration_map, wanted);
+        setIterationLimit(wanted);
+        colourIterationMap(static_cast<std::size_t>(samplesPerSide()), known);
+      }
+    }
+    queueProgressive(known, mouse_y);
+
+    // Zooming in magnifies what is on screen; the border a zoom out uncovers has nothing in it yet
+    auto const unknown = outside(known);
+    auto pixels = std::size_t{0};
+    for (auto const &r : unknown) {
+      pixels += r.area();
+    }
+    auto const factor = governor.factor(pixels);
+    auto const magnified = preview_block / ratio;
+    if (ratio > 1.0 || static_cast<double>(factor) < magnified) {
+      for (auto const &r : unknown) {
+        renderPreview(r, factor);
+      }
+      preview_block = known.area() == 0 ? static_cast<double>(factor)
+                                        : std::max(static_cast<double>(factor), magnified);
+    } else {
+      preview_block = magnified;
+    }
+    presentFrame();
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    updateWindowTitle(
+        std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count()
+    );
+  }
+
+  /// The frame outside `known`: the rows above and below it, then the columns either side.
+  [[nodiscard]] auto outside(mandelbrot::tile::rect known) const
+      -> std::vector<mandelbrot::tile::rect> {
+    auto const known_right = known.x + known.width;
+    auto const known_bottom = known.y + known.height;
+    auto rects = std::vector<mandelbrot::tile::rect>{
+        {0, 0, current_width, known.y},
+        {0, known_bottom, current_width, current_height - known_bottom},
+    };
+    if (known.height != 0) {
+      rects.push_back({0, known.y, known.x, known.height});
+      rects.push_back({known_right, known.y, current_width - known_right, known.height});
+    }
+    std::erase_if(rects, [](auto const &r) { return r.area() == 0; });
+    return rects;
+  }
+
+  /// Queues `region` for progressive rendering in bands of TILE_SIZE rows.
+  void queueRegion(mandelbrot::tile::rect region) {
+    constexpr auto band = mandelbrot::tile::TILE_SIZE;
+    for (auto y = region.y; y < region.y + region.height; y += band) {
+      pending_regions.push_back(
+          {region.x, y, region.width, std::min(band, region.y + region.height - y)}
+      );
+    }
+  }
+
+  /// Queues everything outside `known`, ordered so the bands nearest the focus row are rendered
+  /// first.
+  void queueProgressive(mandelbrot::tile::rect known, int focus_y) {
+    pending_regions.clear();
+    for (auto const &r : outside(known)) {
+      queueRegion(r);
+    }
+
+    auto const distance = [&](mandelbrot::tile::rect const &r) {
+      return std::abs(static_cast<double>(r.y) + r.height / 2.0 - focus_y);
+    };
+    std::ranges::sort(pending_regions, std::greater{}, distance);
+    progressive_start = std::chrono::steady_clock::now();
+  }
+
+  /// Renders queued bands until this frame's budget is spent. Frames with fresh input leave them
+  /// to the previews, so refinement picks up where it was once input stops.
+  void renderPendingRegions() {
+    if (pending_regions.empty() || had_input) {
+      return;
+    }
+    auto const start = std::chrono::steady_clock::now();
+    do {
+      auto const region = pending_regions.back();
+      pending_regions.pop_back();
+      renderRegion(region);
+      uploadRegion(region);
+    } while (!pending_regions.empty() && std::chrono::steady_clock::now() - start < FRAME_BUDGET);
+    temporal.reset(0);
+
+    if (pending_regions.empty()) {
+      preview_block = 1.0;
+      if (usesPixelCost()) {
+        cost_model.record(currentViewport(), pixel_cost);
+      }
+      auto const elapsed = std::chrono::steady_clock::now() - progressive_start;
+      updateWindowTitle(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+    }
+  }
+
+  /// While the view is idle, runs the samples still inside on to the next iteration limit, a slice
+  /// at a time within the frame budget, without touching the escaped ones. Once a step is through
+  /// the frame is recoloured on the new limit's scale; a step that frees almost nothing ends it,
+  /// unless nothing has escaped at all and the samples are not yet known to be inside.
+  void deepenInterior() {
+    if (!deepeningActive() || !pending_regions.empty() || is_dragging || !frameBuffersMatch()) {
+      return;
+    }
+    auto const next = std::ranges::upper_bound(ITERATION_LIMITS, iteration_limit);
+    if (!interior_found) {
+      interior = mandelbrot::tile::find_interior(iteration_map, iteration_limit);
+      interior_found = true;
+      deepened = 0;
+      deepening_start = std::chrono::steady_clock::now();
+    }
+    if (next == ITERATION_LIMITS.end() || interior.empty()) {
+      deepening_finished = true;
+      return;
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+    auto const n = static_cast<std::size_t>(samplesPerSide());
+    auto const vp = currentViewport(n);
+    auto const scheduler = thread_pool->get_scheduler(current_backend);
+    with_iteration_limit(*next, [&]<std::size_t Limit>() {
+      do {
+        // Samples with no orbit kept climb all the way from z = 0
+        auto const from = deepened < interior.fresh ? 0 : interior.iter;
+        auto const slice = std::max(DEEPEN_SLICE_ITERATIONS / (*next - from), batch_d::size);
+        auto const last = std::min(deepened + slice, interior.size());
+        mandelbrot::tile::deepen<Limit>(vp, iteration_map, interior, deepened, last, scheduler);
+        deepened = last;
+      } while (deepened != interior.size() &&
+               std::chrono::steady_clock::now() - start < FRAME_BUDGET);
+    });
+    if (deepened != interior.size()) {
+      return;
+    }
+
+    auto const inside = static_cast<double>(interior.size());
+    auto const escaped = mandelbrot::tile::settle(iteration_map, interior, *next);
+    deepened = 0;
+    setIterationLimit(*next);
+    // A frame nothing has escaped from yet only stops climbing once it is known to be all inside
+    auto const stalled = static_cast<double>(escaped) < inside * DEEPEN_STOP_FRACTION;
+    auto const none_out = interior.size() == iteration_map.iter.size();
+    deepening_finished =
+        interior.empty() ||
+        (stalled && (!none_out || mandelbrot::tile::known_inside(vp, iteration_map, interior)));
+    colourIterationMap(n, fullFrame());
+    presentFrame();
+    auto const elapsed = std::chrono::steady_clock::now() - deepening_start;
+    updateWindowTitle(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+  }
+
+  /// The frame changed: the interior has to be found again before deepening goes on.
+  void restartDeepening() {
+    interior = {};
+    interior_found = false;
+    deepening_finished = false;
+    deepened = 0;
+  }
+
+  [[nodiscard]] auto deepeningActive() const -> bool {
+    return deepening_enabled && !deepening_finished;
+  }
+
+  /// Iteration limit the current view needs, from a low-resolution probe of it.
+  [[nodiscard]] auto chooseLimit() const -> std::size_t {
+    return mandelbrot::tile::choose_limit<ITERATION_LIMITS>(
+        currentViewport(), thread_pool->get_scheduler(current_backend)
+    );
+  }
+
+  void setIterationLimit(std::size_t limit) {
+    if (limit != iteration_limit) {
+      iteration_limit = limit;
+      with_iteration_limit(limit, [&]<std::size_t Limit>() {
+        palettes = mandelbrot::colour::build_palettes<Limit>();
+      });
+    }
+  }
+
+  /// Shows a newly computed frame; it restarts temporal accumulation.
+  void presentFrame() {
+    texture.update(image);
+    temporal.reset(0);
+  }
+
+  /// Runs `compute`, which must report every piece of the frame through finishTile(), on another
+  /// thread while this one uploads the pieces and redraws, so the frame fills in as it renders
+  /// and only the pieces that changed are sent to the texture.
+  void streamFrame(auto &&compute) {
+    auto frame = std::async(std::launch::async, [&] { compute(); });
+    while (frame.wait_for(FRAME_BUDGET) != std::future_status::ready) {
+      uploadFinishedTiles();
+      showLoadingIndicator();
+    }
+    frame.get();
+    uploadFinishedTiles();
+    temporal.reset(0);
+  }
+
+  /// Worker side of a streamed frame: colours `pixels`, whose samples are final, on the calling
+  /// worker and queues them for upload.
+  void finishTile(mandelbrot::tile::rect pixels, std::size_t samples_per_side) {
+    colourIterationMap(samples_per_side, pixels, mandelbrot::inline_scheduler{}, 1);
+    finished_tiles.push(pixels);
+  }
+
+  void uploadFinishedTiles() {
+    while (auto const tile = finished_tiles.try_pop()) {
+      uploadRegion(*tile);
+    }
+  }
+
+  /// Copies `region` of the image to the texture and leaves the rest of the texture alone.
+  void uploadRegion(mandelbrot::tile::rect region) {
+    if (region.area() == 0) {
+      return;
+    }
+    constexpr std::size_t channels = 4;
+    auto const *pixels = image.getPixelsPtr() + (region.y * current_width + region.x) * channels;
+    if (region.width != current_width) {
+      // Rows of a narrower rectangle are not contiguous in the image
+      upload_buffer.resize(region.area() * channels);
+      for (std::size_t y = 0; y != region.height; ++y) {
+        std::memcpy(
+            upload_buffer.data() + y * region.width * channels,
+            pixels + y * current_width * channels,
+            region.width * channels
+        );
+      }
+      pixels = upload_buffer.data();
+    }
+    texture.update(
+        pixels,
+        static_cast<unsigned>(region.width),
+        static_cast<unsigned>(region.height),
+        static_cast<unsigned>(region.x),
+        static_cast<unsigned>(region.y)
+    );
+  }
+
+  /// While the view is idle, adds one jittered sample per pixel to the running average shown.
+  /// The displayed frame counts as the first sample.
+  void accumulateTemporalSample() {
+    if (!temporal_aa_enabled || !pending_regions.empty() || is_dragging || deepeningActive() ||
+        temporal.frames() >= TEMPORAL_AA_SAMPLES) {
+      return;
+    }
+    auto const pixel_count = current_width * current_height;
+    if (temporal.frames() == 0) {
+      temporal.reset(pixel_count);
+      auto const *pixels = image.getPixelsPtr();
+      for (std::size_t i = 0; i != pixel_count; ++i) {
+        temporal.add(
+            i, {pixels[i * 4 + 0] / 255.0f, pixels[i * 4 + 1] / 255.0f, pixels[i * 4 + 2] / 255.0f}
+        );
+      }
+      temporal.finish_frame();
+      temporal_start = std::chrono::steady_clock::now();
+      temporal_row = 0;
+    }
+
+    auto const vp = mandelbrot::tile::jittered(
+        currentViewport(), mandelbrot::tile::jitter(temporal.frames())
+    );
+    auto const scheduler = thread_pool->get_scheduler(current_backend);
+    if (temporal_row == 0) {
+      temporal_map.resize(current_width, current_height);
+    }
+
+    auto accumulate_rows = [&](std::size_t row_start, std::size_t row_end) {
+      alignas(alignof(batch_d)) double iter_buf[batch_d::size];
+      alignas(alignof(batch_d)) double mag_buf[batch_d::size];
+      alignas(alignof(batch_d)) double rgb_buf[3][batch_d::size];
+      for (auto i = row_start * current_width; i < row_end * current_width; i += batch_d::size) {
+        auto const valid = std::min(batch_d::size, row_end * current_width - i);
+        for (std::size_t lane = 0; lane != batch_d::size; ++lane) {
+          iter_buf[lane] = static_cast<double>(temporal_map.iter[i + std::min(lane, valid - 1)]);
+          mag_buf[lane] = temporal_map.mag[i + std::min(lane, valid - 1)];
+        }
+        auto const [r, g, b] =
+            shadeSamples(batch_d::load_aligned(iter_buf), batch_d::load_aligned(mag_buf));
+        r.store_aligned(rgb_buf[0]);
+        g.store_aligned(rgb_buf[1]);
+        b.store_aligned(rgb_buf[2]);
+        for (std::size_t lane = 0; lane != valid; ++lane) {
+          temporal.add(
+              i + lane,
+              {static_cast<float>(rgb_buf[0][lane]),
+               static_cast<float>(rgb_buf[1][lane]),
+               static_cast<float>(rgb_buf[2][lane])}
+          );
+        }
+      }
+    };
+
+    // The jittered frame goes in bands of rows until the frame budget is spent, so input is
+    // handled between them; it counts as a sample once its last band is in
+    auto const slice_start = std::chrono::steady_clock::now();
+    while (temporal_row < current_height &&
+           std::chrono::steady_clock::now() - slice_start < FRAME_BUDGET) {
+      auto const band = mandelbrot::tile::rect{
+          0,
+          temporal_row,
+          current_width,
+          std::min(mandelbrot::tile::TILE_SIZE, current_height - temporal_row)
+      };
+      with_iteration_limit(iteration_limit, [&]<std::size_t Limit>() {
+        mandelbrot::tile::render_region<Limit>(
+            vp, temporal_map, band, scheduler, render_strategy, fillMode()
+        );
+      });
+      mandelbrot::parallel_for_chunked(
+          scheduler,
+          band.height,
+          thread_pool->available_parallelism(),
+          [&](std::size_t row_start, std::size_t row_end) {
+            accumulate_rows(band.y + row_start, band.y + row_end);
+          }
+      );
+      temporal_row += band.height;
+    }
+    if (temporal_row < current_height) {
+      return;
+    }
+    temporal_row = 0;
+    temporal.finish_frame();
+
+    auto resolve_rows = [&](std::size_t row_start, std::size_t row_end) {
+      for (auto py = row_start; py != row_end; ++py) {
+        for (std::size_t px = 0; px != current_width; ++px) {
+          auto const [r, g, b] = temporal.mean(py * current_width + px);
+          image.setPixel(px, py, sf::Color{
+              static_cast<sf::Uint8>(std::clamp(255.0f * r + 0.5f, 0.0f, 255.0f)),
+              static_cast<sf::Uint8>(std::clamp(255.0f * g + 0.5f, 0.0f, 255.0f)),
+              static_cast<sf::Uint8>(std::clamp(255.0f * b + 0.5f, 0.0f, 255.0f))
+          });
+        }
+      }
+    };
+    mandelbrot::parallel_for_chunked(
+        scheduler, current_height, thread_pool->available_parallelism(), resolve_rows
+    );
+    texture.update(image);
+    auto const elapsed = std::chrono::steady_clock::now() - temporal_start;
+    updateWindowTitle(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+  }
+
+  /// Queued regions follow the frame contents when it is panned.
+  void shiftPendingRegions(int dx, int dy) {
+    auto const move = [](std::size_t pos, std::size_t extent, int delta, std::size_t limit) {
+      auto const begin = std::clamp<std::ptrdiff_t>(pos + delta, 0, limit);
+      auto const end = std::clamp<std::ptrdiff_t>(pos + extent + delta, 0, limit);
+      return std::pair{static_cast<std::size_t>(begin), static_cast<std::size_t>(end - begin)};
+    };
+    for (auto &r : pending_regions) {
+      auto const [x, width] = move(r.x, r.width, dx, current_width);
+      auto const [y, height] = move(r.y, r.height, dy, current_height);
+      r = {x, y, width, height};
+    }
+    std::erase_if(pending_regions, [](auto const &r) { return r.area() == 0; });
+  }
+
+  /// Computes and colours one region of the current frame in place.
+  void renderRegion(mandelbrot::tile::rect region) {
+    auto const n = static_cast<std::size_t>(samplesPerSide());
+    if (tile_cache_enabled) {
+      renderCached(region);
+    } else if (adaptiveActive()) {
+      renderAdaptive(region);
+    } else if (isTiled()) {
+      with_iteration_limit(iteration_limit, [&]<std::size_t Limit>() {
+        mandelbrot::tile::render_region<Limit>(
+            currentViewport(n),
+            iteration_map,
+            {region.x * n, region.y * n, region.width * n, region.height * n},
+            thread_pool->get_scheduler(current_backend),
+            render_strategy,
+            fillMode()
+        );
+      });
+      colourIterationMap(n, region);
+    } else {
+      renderUnified(static_cast<int>(n), region);
+    }
+  }
+
+  /// Renders `region` coarsely, one sample per `factor` x `factor` block of pixels, and times it
+  /// for the governor. The blocks fill the image and every sample of the iteration map under
+  /// them, so the region can be recoloured until it is refined.
+  void renderPreview(mandelbrot::tile::rect region, std::size_t factor) {
+    auto const start = std::chrono::steady_clock::now();
+    auto const blocks_x = (region.width + factor - 1) / factor;
+    auto const blocks_y = (region.height + factor - 1) / factor;
+    auto vp = mandelbrot::tile::crop(
+        currentViewport(), {region.x, region.y, blocks_x * factor, blocks_y * factor}
+    );
+    vp.width = blocks_x;
+    vp.height = blocks_y;
+    auto const n = static_cast<std::size_t>(samplesPerSide());
+    auto const scheduler = thread_pool->get_scheduler(current_backend);
+    with_iteration_limit(iteration_limit, [&]<std::size_t Limit>() {
+      mandelbrot::tile::render<Limit>(vp, preview_map, scheduler);
+      mandelbrot::colour::shade<Limit>(
+          preview_map,
+          1,
+          {0, 0, blocks_x, blocks_y},
+          palettes[static_cast<std::size_t>(current_color_scheme)],
+          smooth_coloring_enabled,
+          scheduler,
+          thread_pool->available_parallelism(),
+          [&](std::size_t bx, std::size_t by, sf::Uint8 r, sf::Uint8 g, sf::Uint8 b) {
+            auto const x0 = region.x + bx * factor;
+            auto const x1 = std::min(x0 + factor, region.x + region.width);
+            auto const y0 = region.y + by * factor;
+            auto const y1 = std::min(y0 + factor, region.y + region.height);
+            auto const src = preview_map.index(bx, by);
+            for (auto y = y0; y != y1; ++y) {
+              for (auto x = x0; x != x1; ++x) {
+                image.setPixel(x, y, sf::Color{r, g, b});
+              }
+              for (std::size_t sy = 0; sy != n; ++sy) {
+                auto const row = iteration_map.index(x0 * n, y * n + sy);
+                std::fill_n(iteration_map.iter.begin() + row, (x1 - x0) * n, preview_map.iter[src]);
+                std::fill_n(iteration_map.mag.begin() + row, (x1 - x0) * n, preview_map.mag[src]);
+                iteration_map.forget_orbits(row, row + (x1 - x0) * n);
+              }
+            }
+          }
+      );
+    });
+    governor.record(
+        preview_map.iter.size(),
+        std::reduce(preview_map.iter.begin(), preview_map.iter.end()),
+        std::chrono::steady_clock::now() - start
+    );
+  }
+
+  [[nodiscard]] auto samplesPerSide() const -> int {
+    // Temporal AA replaces spatial supersampling: every frame starts from one sample per pixel
+    return anti_aliasing_enabled && !temporal_aa_enabled ? static_cast<int>(aa_level) : 1;
+  }
+
+  /// What the shortcut strategies may fill for the current colouring.
+  [[nodiscard]] auto fillMode() const -> mandelbrot::tile::fill_mode {
+    return smooth_coloring_enabled ? mandelbrot::tile::fill_mode::interior
+                                   : mandelbrot::tile::fill_mode::bands;
+  }
+
+  [[nodiscard]] auto isTiled() const -> bool {
+    return render_strategy != mandelbrot::tile::strategy::brute_force;
+  }
+
+  [[nodiscard]] auto adaptiveActive() const -> bool {
+    return adaptive_aa_enabled && samplesPerSide() > 1;
+  }
+
+  /// Only the uniform brute-force path tracks per-pixel cost for load balancing.
+  [[nodiscard]] auto usesPixelCost() const -> bool {
+    return !tile_cache_enabled && !isTiled() && !adaptiveActive();
+  }
+
+  /// Whether the retained buffers describe the current frame and can be reused.
+  [[nodiscard]] auto frameBuffersMatch() const -> bool {
+    auto const n = static_cast<std::size_t>(samplesPerSide());
+    return iteration_map.width == current_width * n && iteration_map.height == current_height * n &&
+           (!usesPixelCost() || pixel_cost.size() == current_width * current_height);
+  }
+
+  /// Colour changes only re-run the colour pass over the retained iteration data.
+  void recolour() {
+    if (!frameBuffersMatch()) {
+      render();
+      return;
+    }
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    auto const n = static_cast<std::size_t>(samplesPerSide());
+    colourIterationMap(n, fullFrame());
+    presentFrame();
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    updateWindowTitle(
+        std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count()
+    );
+  }
+
+  /// Streaming colours and reports each band of rows as it finishes; otherwise `region` is
+  /// coloured in one pass at the end.
+  void renderUnified(int samples_per_side, mandelbrot::tile::rect region, bool stream = false) {
+    auto const n = static_cast<std::size_t>(samples_per_side);
+    auto const on_rows = [&](mandelbrot::tile::rect rows) {
+      if (stream) {
+        finishTile(rows, n);
+      }
+    };
     // Dispatch to template specializations for optimal performance
-    auto dispatch_1 = [&]<int SamplesPerSide>() {
-      switch (current_color_scheme) {
-      case ColorScheme::CLASSIC:
-        renderWithSampling<SamplesPerSide, ColorScheme::CLASSIC>();
+    with_iteration_limit(iteration_limit, [&]<std::size_t Limit>() {
+      auto dispatch_1 = [&]<int SamplesPerSide>() {
+        renderWithSampling<Limit, SamplesPerSide>(region, on_rows);
+      };
+      switch (samples_per_side) {
+      case 1:
+        dispatch_1.template operator()<1>();
         break;
-      case ColorScheme::HOT_IRON:
-        renderWithSampling<SamplesPerSide, ColorScheme::HOT_IRON>();
+      case 2:
+        dispatch_1.template operator()<2>();
         break;
-      case ColorScheme::ELECTRIC_BLUE:
-        renderWithSampling<SamplesPerSide, ColorScheme::ELECTRIC_BLUE>();
+      case 3:
+        dispatch_1.template operator()<3>();
         break;
-      case ColorScheme::SUNSET:
-        renderWithSampling<SamplesPerSide, ColorScheme::SUNSET>();
-        break;
-      case ColorScheme::GRAYSCALE:
-        renderWithSampling<SamplesPerSide, ColorScheme::GRAYSCALE>();
-        break;
-      case ColorScheme::BLUE_WHITE:
-        renderWithSampling<SamplesPerSide, ColorScheme::BLUE_WHITE>();
-        break;
-      case ColorScheme::EXPONENTIAL_LCH:
-        renderWithSampling<SamplesPerSide, ColorScheme::EXPONENTIAL_LCH>();
-        break;
-      case ColorScheme::RAINBOW_SPIRAL:
-        renderWithSampling<SamplesPerSide, ColorScheme::RAINBOW_SPIRAL>();
-        break;
-      case ColorScheme::OCEAN_DEPTHS:
-        renderWithSampling<SamplesPerSide, ColorScheme::OCEAN_DEPTHS>();
-        break;
-      case ColorScheme::LAVA_FLOW:
-        renderWithSampling<SamplesPerSide, ColorScheme::LAVA_FLOW>();
-        break;
-      case ColorScheme::CHERRY_BLOSSOM:
-        renderWithSampling<SamplesPerSide, ColorScheme::CHERRY_BLOSSOM>();
-        break;
-      case ColorScheme::NEON_CYBERPUNK:
-        renderWithSampling<SamplesPerSide, ColorScheme::NEON_CYBERPUNK>();
-        break;
-      case ColorScheme::AUTUMN_FOREST:
-        renderWithSampling<SamplesPerSide, ColorScheme::AUTUMN_FOREST>();
-        break;
-      case ColorScheme::COUNT:
-        renderWithSampling<SamplesPerSide, ColorScheme::COUNT>();
+      case 4:
+        dispatch_1.template operator()<4>();
         break;
+      default:
+        dispatch_1.template operator()<1>();
+        break; // Runtime fallback
       }
+    });
+
+    if (!stream) {
+      colourIterationMap(n, region);
+    }
+  }
+
+  /// One sample per pixel (plus a one-pixel ring for the contrast test) with the current
+  /// strategy, then the full sample grid only where neighbouring colours differ. Returns the
+  /// number of pixels refined.
+  auto renderAdaptive(mandelbrot::tile::rect region) -> std::size_t {
+    auto const n = static_cast<std::size_t>(samplesPerSide());
+    auto const vp = currentViewport();
+    auto const scheduler = thread_pool->get_scheduler(current_backend);
+    auto const area = mandelbrot::tile::grow(region, 1, current_width, current_height);
+    adaptive_centres.resize(current_width, current_height);
+    auto const refined = with_iteration_limit(iteration_limit, [&]<std::size_t Limit>() {
+      auto const iterated = mandelbrot::tile::render_region<Limit>(
+          vp, adaptive_centres, area, scheduler, render_strategy, fillMode()
+      );
+      iterated_fraction = static_cast<double>(iterated) / static_cast<double>(area.area());
+      return mandelbrot::tile::refine_adaptive<Limit>(
+          vp, adaptive_centres, iteration_map, n, region, scheduler, smooth_coloring_enabled
+      );
+    });
+    colourIterationMap(n, region);
+    return refined;
+  }
+
+  /// Fills a region from world tiles, computing only those not in the cache.
+  void renderCached(mandelbrot::tile::rect region) {
+    auto const n = static_cast<std::size_t>(samplesPerSide());
+    with_iteration_limit(iteration_limit, [&]<std::size_t Limit>() {
+      mandelbrot::tile::render_cached<Limit>(
+          currentViewport(),
+          iteration_map,
+          n,
+          region,
+          thread_pool->get_scheduler(current_backend),
+          tile_cache
+      );
+    });
+    colourIterationMap(n, region);
+  }
+
+  [[nodiscard]] auto fullFrame() const -> mandelbrot::tile::rect {
+    return {0, 0, current_width, current_height};
+  }
+
+  [[nodiscard]] auto currentViewport(std::size_t samples_per_side = 1) const
+      -> mandelbrot::tile::viewport {
+    return {
+        center_x,
+        center_y,
+        zoom,
+        current_width * samples_per_side,
+        current_height * samples_per_side
     };
-    switch (samples_per_side) {
-    case 1:
-      dispatch_1.operator()<1>();
-      break;
-    case 2:
-      dispatch_1.operator()<2>();
-      break;
-    case 3:
-      dispatch_1.operator()<3>();
-      break;
-    case 4:
-      dispatch_1.operator()<4>();
-      break;
-    default:
-      dispatch_1.operator()<1>();
-      break; // Runtime fallback
+  }
+
+  /// Streaming colours each tile as it finishes (samples_per_side must divide TILE_SIZE);
+  /// otherwise the frame is coloured in one pass at the end.
+  void renderTiled(int samples_per_side, bool stream = false) {
+    // Supersampling renders a proportionally larger viewport whose pixel grid is the sample grid
+    auto const n = static_cast<std::size_t>(samples_per_side);
+    auto const vp = currentViewport(n);
+    auto const on_tile = [&](mandelbrot::tile::rect r) {
+      finishTile({r.x / n, r.y / n, r.width / n, r.height / n}, n);
+    };
+    auto const computed = with_iteration_limit(iteration_limit, [&]<std::size_t Limit>() {
+      auto const scheduler = thread_pool->get_scheduler(current_backend);
+      if (stream) {
+        return mandelbrot::tile::render<Limit>(
+            vp, iteration_map, scheduler, render_strategy, fillMode(), on_tile
+        );
+      }
+      return mandelbrot::tile::render<Limit>(
+          vp, iteration_map, scheduler, render_strategy, fillMode()
+      );
+    });
+    iterated_fraction = static_cast<double>(computed) / static_cast<double>(vp.width * vp.height);
+
+    if (!stream) {
+      colourIterationMap(n, fullFrame());
     }
   }
 
-  template <int SamplesPerSide, ColorScheme colour>
-  void renderWithSampling() {
+  void colourIterationMap(std::size_t samples_per_side, mandelbrot::tile::rect region) {
+    colourIterationMap(
+        samples_per_side,
+        region,
+        thread_pool->get_scheduler(current_backend),
+        thread_pool->available_parallelism()
+    );
+  }
+
+  void colourIterationMap(
+      std::size_t samples_per_side,
+      mandelbrot::tile::rect region,
+      auto scheduler,
+      std::size_t workers
+  ) {
+    with_iteration_limit(iteration_limit, [&]<std::size_t Limit>() {
+      mandelbrot::colour::shade<Limit>(
+          iteration_map,
+          samples_per_side,
+          region,
+          palettes[static_cast<std::size_t>(current_color_scheme)],
+          smooth_coloring_enabled,
+          scheduler,
+          workers,
+          [&](std::size_t x, std::size_t y, sf::Uint8 r, sf::Uint8 g, sf::Uint8 b) {
+            image.setPixel(x, y, sf::Color{r, g, b});
+          }
+      );
+    });
+  }
+
+  /// Colours a batch of samples; returns sRGB components ready for averaging.
+  [[nodiscard]] auto shadeSamples(const batch_d &iter_batch, const batch_d &mag_batch) const
+      -> std::tuple<batch_d, batch_d, batch_d> {
+    auto const t = with_iteration_limit(iteration_limit, [&]<std::size_t Limit>() {
+      return mandelbrot::colour::normalized<Limit>(iter_batch, mag_batch, smooth_coloring_enabled);
+    });
+    return palettes[static_cast<std::size_t>(current_color_scheme)].sample(t);
+  }
+
+  /// Compute pass of the per-pixel renderer: fills the iteration map's samples for `region`,
+  /// passing each finished band of at most TILE_SIZE rows to `on_rows` on its worker.
+  template <std::size_t Limit, int SamplesPerSide>
+  void renderWithSampling(mandelbrot::tile::rect region, auto &&on_rows) {
     constexpr auto const samples_per_pixel = SamplesPerSide * SamplesPerSide;
 
     // Pre-calculate coordinate transformation constants
@@ -1047,189 +1551,95 @@ private:
     const batch_d center_y_batch = batch_d(center_y);
     const batch_d scale_batch = batch_d(scale);
 
-    constexpr auto BUF_N = samples_per_pixel + (batch_d::size - 1) / batch_d::size;
+    auto const sample_width = iteration_map.width;
 
     auto coordinate_generator = [&](std::size_t px_start, std::size_t px_end) {
-      auto const needed_pixels = px_end - px_start;
-      auto const needed_samples = needed_pixels * samples_per_pixel;
-      auto const total_batches = (needed_samples + batch_d::size - 1) / batch_d::size;
-
+      auto const needed_samples = (px_end - px_start) * samples_per_pixel;
       auto const sample_start = px_start * samples_per_pixel;
 
-      auto iteration_buffer = std::array<xsimd::batch<double>, BUF_N>{};
-      auto mag_buffer = std::array<xsimd::batch<double>, BUF_N>{};
-      auto current_buf = 0uz;
-      auto write = 0uz;
-      auto read = 0uz;
+      alignas(alignof(xsimd::batch<std::size_t>)) std::size_t iter_buf[batch_d::size];
+      alignas(alignof(batch_d)) double mag_buf[batch_d::size];
+      alignas(alignof(batch_d)) double x_buf[batch_d::size];
+      alignas(alignof(batch_d)) double y_buf[batch_d::size];
+      std::fill(pixel_cost.begin() + px_start, pixel_cost.begin() + px_end, 0);
 
-      auto sample_base = sample_start;
-      for (std::size_t i = 0; i != total_batches; ++i) {
+      for (std::size_t offset = 0; offset < needed_samples; offset += batch_d::size) {
         // coords
-        auto const sample_index = iota_batch(sample_base);
+        auto const sample_index = iota_batch(sample_start + offset);
         auto const pixel_index = sample_index / samples_per_pixel;
         auto const sub_sample_index = sample_index % samples_per_pixel;
 
         auto const px = xsimd::batch_cast<double>(pixel_index % current_width);
         auto const py = xsimd::batch_cast<double>(pixel_index / current_width);
 
-        auto const sx = xsimd::batch_cast<double>((sub_sample_index % SamplesPerSide) + 1);
-        auto const sy = xsimd::batch_cast<double>((sub_sample_index / SamplesPerSide) + 1);
+        auto const sx = xsimd::batch_cast<double>(sub_sample_index % SamplesPerSide);
+        auto const sy = xsimd::batch_cast<double>(sub_sample_index / SamplesPerSide);
 
-        // Pre-calculated constant for subpixel sampling
-        const auto sub_distance = batch_d{1.0 / (SamplesPerSide + 1)};
-        auto const sub_x = px + sub_distance * sx;
-        auto const sub_y = py + sub_distance * sy;
+        // Subsample k of n sits at (k + 0.5) / n across the pixel, as on the tiled renderer's
+        // grid, so deepening finds each sample where it was rendered
+        const auto sub_distance = batch_d{1.0 / SamplesPerSide};
+        auto const sub_x = px + sub_distance * (sx + 0.5);
+        auto const sub_y = py + sub_distance * (sy + 0.5);
 
         auto const real = center_x_batch + (sub_x - offset_x_batch) * scale_batch;
         auto const imag = center_y_batch - (sub_y - offset_y_batch) * scale_batch;
 
         // mandelbrot
-        auto [iter, mag] = mandelbrot_simd<MAX_ITER>(real, imag);
-        iteration_buffer[current_buf] = xsimd::batch_cast<double>(iter);
-        mag_buffer[current_buf] = mag;
-        write += batch_d::size;
-
-        // collect colour
-        while (write - read >= samples_per_pixel) {
-
-          xsimd::batch<double> r_acc = xsimd::batch<double>{};
-          xsimd::batch<double> g_acc = xsimd::batch<double>{};
-          xsimd::batch<double> b_acc = xsimd::batch<double>{};
-          xsimd::batch<size_t> count_mask = xsimd::batch<size_t>{};
-          size_t batch_count = (samples_per_pixel + batch_d::size - 1) / batch_d::size;
-          for (std::size_t i = 0; i != batch_count; ++i) {
-            std::size_t logical_index = read + i * batch_d::size;
-            std::size_t buf_idx = (logical_index / batch_d::size) % BUF_N;
-            std::size_t start_offset = logical_index % batch_d::size;
-            const auto &iter_batch = iteration_buffer[buf_idx];
-            const auto &mag_batch = mag_buffer[buf_idx];
-
-            // Simplified masking - only process valid lanes within this batch
-            auto const remaining_samples = samples_per_pixel - i * batch_d::size;
-            auto const iota = iota_batch<size_t>(0u);
-            auto const lanes = std::min(batch_d::size, remaining_samples);
-            auto const mask =
-                (xsimd::batch{start_offset} <= iota) && (iota < xsimd::batch{start_offset + lanes});
-
-            auto const mask_d = xsimd::batch_bool_cast<double>(mask);
-
-            // Smooth coloring using both iterations and escape magnitude (if enabled)
-            batch_d final_iter;
-            if (smooth_coloring_enabled) {
-              auto escaped_mask = mag_batch > batch_d(4.0);
-              auto smooth_iter =
-                  iter_batch - xsimd::log2(xsimd::log2(mag_batch)) + xsimd::log2(xsimd::log2(4.0));
-              final_iter = select(escaped_mask, smooth_iter, iter_batch);
-            } else {
-              final_iter = iter_batch; // Use raw iteration count
-            }
-
-            // Calculate normalized t for most color schemes (expensive logarithm)
-            auto t = xsimd::log(final_iter + 1.0) / xsimd::log(static_cast<double>(MAX_ITER + 1));
-
-            xsimd::batch<double> r, g, b;
-            switch (colour) {
-            case ColorScheme::CLASSIC:
-              std::tie(r, g, b) = getClassicColor_simd(t);
-              break;
-            case ColorScheme::HOT_IRON:
-              std::tie(r, g, b) = getHotIronColor_simd(t);
-              break;
-            case ColorScheme::ELECTRIC_BLUE:
-              std::tie(r, g, b) = getElectricBlueColor_simd(t);
-              break;
-            case ColorScheme::SUNSET:
-              std::tie(r, g, b) = getSunsetColor_simd(t);
-              break;
-            case ColorScheme::GRAYSCALE:
-              std::tie(r, g, b) = getGrayscaleColor_simd(t);
-              break;
-            case ColorScheme::EXPONENTIAL_LCH:
-              std::tie(r, g, b) =
-                  getExponentialLCH_simd(final_iter); // Uses smooth iterations directly
-              break;
-            case ColorScheme::BLUE_WHITE:
-              std::tie(r, g, b) = getBlueWhiteColor_simd(t);
-              break;
-            case ColorScheme::RAINBOW_SPIRAL:
-              std::tie(r, g, b) = getRainbowSpiralColor_simd(t);
-              break;
-            case ColorScheme::OCEAN_DEPTHS:
-              std::tie(r, g, b) = getOceanDepthsColor_simd(t);
-              break;
-            case ColorScheme::LAVA_FLOW:
-              std::tie(r, g, b) = getLavaFlowColor_simd(t);
-              break;
-            case ColorScheme::CHERRY_BLOSSOM:
-              std::tie(r, g, b) = getCherryBlossomColor_simd(t);
-              break;
-            case ColorScheme::NEON_CYBERPUNK:
-              std::tie(r, g, b) = getNeonCyberpunkColor_simd(t);
-              break;
-            case ColorScheme::AUTUMN_FOREST:
-              std::tie(r, g, b) = getAutumnForestColor_simd(t);
-              break;
-            default:
-              // Error fallback - render white to make it obvious
-              r = batch_d(1.0);
-              g = batch_d(1.0);
-              b = batch_d(1.0);
-              break;
-            }
-
-            // Convert to sRGB space before accumulation for proper gamma-correct averaging
-            auto srgb_r = gammaCorrect_simd(r);
-            auto srgb_g = gammaCorrect_simd(g);
-            auto srgb_b = gammaCorrect_simd(b);
-            
-            // Accumulate colors only for valid samples (masked samples are automatically 0)
-            r_acc += select(mask_d, srgb_r, batch_d(0.0));
-            g_acc += select(mask_d, srgb_g, batch_d(0.0));
-            b_acc += select(mask_d, srgb_b, batch_d(0.0));
-            count_mask += select(mask, xsimd::batch<size_t>(1), xsimd::batch<size_t>(0));
-          }
-          double r_sum = xsimd::reduce_add(r_acc);
-          double g_sum = xsimd::reduce_add(g_acc);
-          double b_sum = xsimd::reduce_add(b_acc);
-          std::size_t count = xsimd::reduce_add(count_mask);
-          
-          // Average in sRGB space (samples already converted during accumulation)
-          double srgb_r = r_sum / count;
-          double srgb_g = g_sum / count;
-          double srgb_b = b_sum / count;
-          
-          sf::Color final_color{
-              static_cast<sf::Uint8>(std::clamp(255.0 * srgb_r, 0.0, 255.0)),
-              static_cast<sf::Uint8>(std::clamp(255.0 * srgb_g, 0.0, 255.0)),
-              static_cast<sf::Uint8>(std::clamp(255.0 * srgb_b, 0.0, 255.0))
-          };
-
-          std::size_t pixel_index = read / samples_per_pixel;
-          std::size_t actual_pixel_idx = px_start + pixel_index;
-          if (actual_pixel_idx < current_width * current_height) {
-            std::size_t px = actual_pixel_idx % current_width;
-            std::size_t py = actual_pixel_idx / current_width;
-            image.setPixel(px, py, final_color);
-          }
-
-          read += samples_per_pixel;
+        auto x = batch_d(0.0);
+        auto y = batch_d(0.0);
+        auto [iter, mag] = mandelbrot_simd<Limit>(real, imag, x, y);
+        iter.store_aligned(iter_buf);
+        mag.store_aligned(mag_buf);
+        x.store_aligned(x_buf);
+        y.store_aligned(y_buf);
+
+        // Scatter into the sample grid shared with the tiled renderer; colouring is a later pass
+        auto const valid = std::min(batch_d::size, needed_samples - offset);
+        for (std::size_t lane = 0; lane != valid; ++lane) {
+          auto const sample = sample_start + offset + lane;
+          auto const pixel = sample / samples_per_pixel;
+          auto const sub = sample % samples_per_pixel;
+          auto const row = (pixel / current_width) * SamplesPerSide + sub / SamplesPerSide;
+          auto const column = (pixel % current_width) * SamplesPerSide + sub % SamplesPerSide;
+          iteration_map.iter[row * sample_width + column] = iter_buf[lane];
+          iteration_map.mag[row * sample_width + column] = mag_buf[lane];
+          iteration_map.keep_orbit(row * sample_width + column, x_buf[lane], y_buf[lane]);
+          pixel_cost[pixel] += iter_buf[lane];
         }
-
-        // update for next batch
-        current_buf = (current_buf + 1) % BUF_N;
-        sample_base += batch_d::size;
       }
     };
 
-    auto scheduler = stdexec::schedule(thread_pool->get_scheduler());
-    stdexec::sender auto sender = stdexec::bulk_chunked(
-        scheduler,
-        stdexec::par,
-        current_width * current_height,
-        coordinate_generator
+    // One band of rows per worker, sized by the previous frame's reprojected iteration cost
+    auto row_costs = std::vector<double>(current_height, 1.0);
+    if (!cost_model.empty()) {
+      row_costs = cost_model.predict_rows(currentViewport());
+    }
+    auto const row_bounds = mandelbrot::tile::partition(
+        std::span(row_costs).subspan(region.y, region.height), thread_pool->available_parallelism()
     );
 
-    stdexec::sync_wait(sender);
+    pixel_cost.resize(current_width * current_height);
+    auto const report = mandelbrot::tile::run_partitioned(
+        thread_pool->get_scheduler(current_backend),
+        row_bounds,
+        [&](std::size_t row_begin, std::size_t row_end) {
+          constexpr auto band = mandelbrot::tile::TILE_SIZE;
+          for (auto begin = row_begin; begin < row_end; begin += band) {
+            auto const end = std::min(begin + band, row_end);
+            auto const first = (region.y + begin) * current_width + region.x;
+            if (region.width == current_width) {
+              coordinate_generator(first, first + (end - begin) * current_width);
+            } else {
+              for (auto row = first; row < first + (end - begin) * current_width;
+                   row += current_width) {
+                coordinate_generator(row, row + region.width);
+              }
+            }
+            on_rows(mandelbrot::tile::rect{region.x, region.y + begin, region.width, end - begin});
+          }
+        }
+    );
+    idle_fraction = report.idle_fraction;
   }
 
   // ===== UI MANAGEMENT =====
@@ -1379,14 +1789,42 @@ private:
     const auto scheme_name = getColorSchemeName(current_color_scheme);
     title_stream << "Mandelbrot Viewer [" << scheme_name << "]";
     
-    if (anti_aliasing_enabled) {
+    if (temporal_aa_enabled) {
+      title_stream << " AA:Temporal " << std::max<std::size_t>(temporal.frames(), 1) << "/"
+                   << TEMPORAL_AA_SAMPLES;
+    } else if (anti_aliasing_enabled) {
       const auto aa_samples = static_cast<int>(aa_level) * static_cast<int>(aa_level);
       title_stream << " AA:" << aa_samples << "x";
+      if (adaptiveActive()) {
+        title_stream << " Adaptive:" << static_cast<int>(refined_fraction * 100.0 + 0.5) << "%";
+      }
     } else {
       title_stream << " AA:Off";
     }
     
     title_stream << (smooth_coloring_enabled ? " Smooth:On" : " Smooth:Off");
+    if (render_strategy != mandelbrot::tile::strategy::brute_force) {
+      title_stream << " " << mandelbrot::tile::to_string(render_strategy) << ":"
+                   << static_cast<int>(iterated_fraction * 100.0 + 0.5) << "%";
+    } else if (!adaptiveActive()) {
+      title_stream << " Idle:" << static_cast<int>(idle_fraction * 100.0 + 0.5) << "%";
+    }
+    title_stream << " Iter:" << (auto_limit_enabled ? "Auto " : "") << iteration_limit;
+    if (deepeningActive()) {
+      title_stream << "+";
+    }
+    title_stream << " " << mandelbrot::to_string(current_backend) << " " << std::fixed
+                 << std::setprecision(1) << governor.giters_per_second() << "Gi/s";
+    if (!pending_regions.empty() && preview_block > 1.0) {
+      title_stream << " Preview:1/" << static_cast<int>(preview_block + 0.5);
+    }
+    if (tile_cache_enabled) {
+      title_stream << " Cache:" << static_cast<int>(tile_cache.hit_rate() * 100.0 + 0.5) << "% "
+                   << (tile_cache.size_bytes() >> 20) << "MB";
+      if (tile_store) {
+        title_stream << " Disk:" << (tile_store->size_bytes() >> 20) << "MB";
+      }
+    }
     title_stream << " - " << render_time_ms << "ms";
     
     if (!show_help) {
@@ -1397,36 +1835,7 @@ private:
   }
 
   [[nodiscard]] constexpr std::string_view getColorSchemeName(ColorScheme scheme) const noexcept {
-    switch (scheme) {
-    case ColorScheme::CLASSIC:
-      return "Ultra Fractal Classic";
-    case ColorScheme::HOT_IRON:
-      return "Hot Iron";
-    case ColorScheme::ELECTRIC_BLUE:
-      return "Electric Blue";
-    case ColorScheme::SUNSET:
-      return "Sunset";
-    case ColorScheme::GRAYSCALE:
-      return "Grayscale";
-    case ColorScheme::BLUE_WHITE:
-      return "Blue to White";
-    case ColorScheme::EXPONENTIAL_LCH:
-      return "Exponential LCH";
-    case ColorScheme::RAINBOW_SPIRAL:
-      return "Rainbow Spiral";
-    case ColorScheme::OCEAN_DEPTHS:
-      return "Ocean Depths";
-    case ColorScheme::LAVA_FLOW:
-      return "Lava Flow";
-    case ColorScheme::CHERRY_BLOSSOM:
-      return "Cherry Blossom";
-    case ColorScheme::NEON_CYBERPUNK:
-      return "Neon Cyberpunk";
-    case ColorScheme::AUTUMN_FOREST:
-      return "Autumn Forest";
-    default:
-      return "Unknown";
-    }
+    return mandelbrot::colour::to_string(static_cast<mandelbrot::colour::scheme>(scheme));
   }
 };
 